@@ -0,0 +1,537 @@
+/*
+*  MIT License
+*  
+*  Copyright (c) 2025 Pawel Drzycimski
+*  
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*  
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+*  
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*
+*/
+
+#ifndef PDY_EXPECTED_HPP_
+#define PDY_EXPECTED_HPP_
+
+#include "Optional.hpp"
+
+#include <type_traits>
+#include <utility>
+
+/*
+*  Expected<T, E> holds either a T or an error E, for calls that need to say why they failed
+*  without throwing.
+*
+*  T and E share one union behind a single discriminant, the same way Optional<T> keeps its
+*  value, so sizeof(Expected<T, E>) is max(sizeof(T), sizeof(E)) plus the flag rounded up to
+*  the alignment. With both T and E trivially destructible, so is Expected.
+*
+*  Expected<int, Errc> parse(const char *str);
+*
+*  auto port = parse(str)
+*    .and_then(check_range)
+*    .transform([](int v) { return static_cast<uint16_t>(v); });
+*
+*  if(!port)
+*    log(port.error());
+*/
+
+template<typename E>
+class Unexpected final
+{
+  E m_error;
+
+public:
+  explicit constexpr Unexpected(const E &err) noexcept(detail::is_noexcept_copy_constructible<E>::value)
+    : m_error(err)
+  {}
+
+  explicit constexpr Unexpected(E &&err) noexcept(detail::is_noxcept_move_constructible<E>::value)
+    : m_error(std::move(err))
+  {}
+
+  constexpr const E& error() const & noexcept { return m_error; }
+  E& error() & noexcept { return m_error; }
+  E&& error() && noexcept { return std::move(m_error); }
+};
+
+template<typename E>
+Unexpected<typename std::decay<E>::type> make_unexpected(E &&err)
+{
+  return Unexpected<typename std::decay<E>::type>(std::forward<E>(err));
+}
+
+namespace detail {
+
+struct expected_value_tag {};
+struct expected_error_tag {};
+struct expected_copy_tag {};
+
+template<typename F, typename Arg>
+using expected_result_t = typename std::decay<decltype(std::declval<F>()(std::declval<Arg>()))>::type;
+
+// same shape as storage<T, TrivialDtor> with the error as the second union member,
+// 'engaged' tells which one is alive
+template<typename T, typename E,
+  bool TrivialDtor = std::is_trivially_destructible<T>::value && std::is_trivially_destructible<E>::value>
+struct expected_storage
+{
+  union {
+    char dummy;
+    T value;
+    E error;
+  };
+
+  bool engaged;
+
+  template<typename ...Args>
+  explicit constexpr expected_storage(expected_value_tag, Args&& ...args)
+    : value(std::forward<Args>(args)...), engaged{true}
+  {}
+
+  template<typename ...Args>
+  explicit constexpr expected_storage(expected_error_tag, Args&& ...args)
+    : error(std::forward<Args>(args)...), engaged{false}
+  {}
+
+  // constructing in the body, a throwing copy leaves no half alive member to destroy
+  template<typename Src>
+  expected_storage(expected_copy_tag, Src &&src)
+    : dummy{0}, engaged{src.engaged}
+  {
+    if(engaged)
+      ::new(static_cast<void*>(std::addressof(value))) T(std::forward<Src>(src).value);
+    else
+      ::new(static_cast<void*>(std::addressof(error))) E(std::forward<Src>(src).error);
+  }
+
+  ~expected_storage() = default;
+};
+
+template<typename T, typename E>
+struct expected_storage<T, E, false>
+{
+  union {
+    char dummy;
+    T value;
+    E error;
+  };
+
+  bool engaged;
+
+  template<typename ...Args>
+  explicit constexpr expected_storage(expected_value_tag, Args&& ...args)
+    : value(std::forward<Args>(args)...), engaged{true}
+  {}
+
+  template<typename ...Args>
+  explicit constexpr expected_storage(expected_error_tag, Args&& ...args)
+    : error(std::forward<Args>(args)...), engaged{false}
+  {}
+
+  template<typename Src>
+  expected_storage(expected_copy_tag, Src &&src)
+    : dummy{0}, engaged{src.engaged}
+  {
+    if(engaged)
+      ::new(static_cast<void*>(std::addressof(value))) T(std::forward<Src>(src).value);
+    else
+      ::new(static_cast<void*>(std::addressof(error))) E(std::forward<Src>(src).error);
+  }
+
+  ~expected_storage() noexcept(is_noexcept_destructible<T>::value && is_noexcept_destructible<E>::value)
+  {
+    if(engaged)
+      value.T::~T();
+    else
+      error.E::~E();
+  }
+};
+
+// builds *slot back from *saved during unwinding unless 'saved' was cleared,
+// so a throwing constructor never leaves the storage without a live member
+template<typename U>
+struct expected_restore
+{
+  U *slot;
+  U *saved;
+
+  ~expected_restore()
+  {
+    if(saved)
+      ::new(static_cast<void*>(slot)) U(std::move(*saved));
+  }
+};
+
+template<int N>
+using expected_reinit_tag = std::integral_constant<int, N>;
+
+} // namespace detail
+
+template<typename T, typename E>
+class Expected final
+{
+  static_assert(!std::is_reference<T>::value && !std::is_reference<E>::value, "Expected does not hold references");
+  static_assert(!std::is_void<T>::value, "Expected<void, E> is not supported, use Optional<E>");
+
+  detail::expected_storage<T, E> m_storage;
+
+  // New takes the place of the alive Old member and a throwing constructor leaves Old
+  // in place: New is built in a temporary first or, when New can throw on move too, Old
+  // moves aside and is put back. As with std::expected, T or E needs a noexcept move.
+  template<typename New, typename Old, typename ...Args>
+  static void reinit(New &newMember, Old &oldMember, Args&& ...args)
+  {
+    reinit(detail::expected_reinit_tag<std::is_nothrow_constructible<New, Args...>::value ? 0 :
+      std::is_nothrow_move_constructible<New>::value ? 1 : 2>{},
+      newMember, oldMember, std::forward<Args>(args)...);
+  }
+
+  template<typename New, typename Old, typename ...Args>
+  static void reinit(detail::expected_reinit_tag<0>, New &newMember, Old &oldMember, Args&& ...args)
+  {
+    oldMember.~Old();
+    ::new(static_cast<void*>(std::addressof(newMember))) New(std::forward<Args>(args)...);
+  }
+
+  template<typename New, typename Old, typename ...Args>
+  static void reinit(detail::expected_reinit_tag<1>, New &newMember, Old &oldMember, Args&& ...args)
+  {
+    New tmp(std::forward<Args>(args)...);
+    oldMember.~Old();
+    ::new(static_cast<void*>(std::addressof(newMember))) New(std::move(tmp));
+  }
+
+  template<typename New, typename Old, typename ...Args>
+  static void reinit(detail::expected_reinit_tag<2>, New &newMember, Old &oldMember, Args&& ...args)
+  {
+    static_assert(std::is_nothrow_move_constructible<Old>::value, "Expected needs T or E with a noexcept move");
+
+    Old saved(std::move(oldMember));
+    oldMember.~Old();
+    detail::expected_restore<Old> guard{std::addressof(oldMember), std::addressof(saved)};
+    ::new(static_cast<void*>(std::addressof(newMember))) New(std::forward<Args>(args)...);
+    guard.saved = nullptr;
+  }
+
+  template<typename ...Args>
+  void reinit_value(Args&& ...args)
+  {
+    reinit(m_storage.value, m_storage.error, std::forward<Args>(args)...);
+    m_storage.engaged = true;
+  }
+
+  template<typename ...Args>
+  void reinit_error(Args&& ...args)
+  {
+    reinit(m_storage.error, m_storage.value, std::forward<Args>(args)...);
+    m_storage.engaged = false;
+  }
+
+  // the side holding the member with the noexcept move gives it up first,
+  // it can be put back if building the other one throws
+  static void swap_states(Expected<T, E> &withValue, Expected<T, E> &withError, std::true_type /*E moves noexcept*/)
+  {
+    E tmp(std::move(withError.m_storage.error));
+    withError.m_storage.error.E::~E();
+    {
+      detail::expected_restore<E> guard{std::addressof(withError.m_storage.error), std::addressof(tmp)};
+      ::new(static_cast<void*>(std::addressof(withError.m_storage.value))) T(std::move(withValue.m_storage.value));
+      guard.saved = nullptr;
+    }
+    withError.m_storage.engaged = true;
+
+    withValue.m_storage.value.T::~T();
+    ::new(static_cast<void*>(std::addressof(withValue.m_storage.error))) E(std::move(tmp));
+    withValue.m_storage.engaged = false;
+  }
+
+  static void swap_states(Expected<T, E> &withValue, Expected<T, E> &withError, std::false_type /*E moves noexcept*/)
+  {
+    static_assert(std::is_nothrow_move_constructible<T>::value, "Expected needs T or E with a noexcept move");
+
+    T tmp(std::move(withValue.m_storage.value));
+    withValue.m_storage.value.T::~T();
+    {
+      detail::expected_restore<T> guard{std::addressof(withValue.m_storage.value), std::addressof(tmp)};
+      ::new(static_cast<void*>(std::addressof(withValue.m_storage.error))) E(std::move(withError.m_storage.error));
+      guard.saved = nullptr;
+    }
+    withValue.m_storage.engaged = false;
+
+    withError.m_storage.error.E::~E();
+    ::new(static_cast<void*>(std::addressof(withError.m_storage.value))) T(std::move(tmp));
+    withError.m_storage.engaged = true;
+  }
+
+public:
+  using value_type = T;
+  using error_type = E;
+
+  Expected()
+    : m_storage(detail::expected_value_tag{})
+  {}
+
+  constexpr Expected(const T &val) noexcept(detail::is_noexcept_copy_constructible<T>::value)
+    : m_storage(detail::expected_value_tag{}, val)
+  {}
+
+  constexpr Expected(T &&val) noexcept(detail::is_noxcept_move_constructible<T>::value)
+    : m_storage(detail::expected_value_tag{}, std::move(val))
+  {}
+
+  constexpr Expected(const Unexpected<E> &err) noexcept(detail::is_noexcept_copy_constructible<E>::value)
+    : m_storage(detail::expected_error_tag{}, err.error())
+  {}
+
+  Expected(Unexpected<E> &&err) noexcept(detail::is_noxcept_move_constructible<E>::value)
+    : m_storage(detail::expected_error_tag{}, std::move(err).error())
+  {}
+
+  Expected(const Expected<T, E> &other)
+    noexcept(detail::is_noexcept_copy_constructible<T>::value && detail::is_noexcept_copy_constructible<E>::value)
+    : m_storage(detail::expected_copy_tag{}, other.m_storage)
+  {}
+
+  Expected(Expected<T, E> &&other)
+    noexcept(detail::is_noxcept_move_constructible<T>::value && detail::is_noxcept_move_constructible<E>::value)
+    : m_storage(detail::expected_copy_tag{}, std::move(other.m_storage))
+  {}
+
+  ~Expected() = default;
+
+  // same side: T's or E's own assignment, otherwise the new member replaces the old one
+  Expected<T, E>& operator=(const Expected<T, E> &other)
+  {
+    if(has_value() && other.has_value())
+      m_storage.value = other.m_storage.value;
+    else if(!has_value() && !other.has_value())
+      m_storage.error = other.m_storage.error;
+    else if(other.has_value())
+    {
+      reinit_value(other.m_storage.value);
+    }
+    else
+    {
+      reinit_error(other.m_storage.error);
+    }
+
+    return *this;
+  }
+
+  Expected<T, E>& operator=(Expected<T, E> &&other)
+  {
+    if(has_value() && other.has_value())
+      m_storage.value = std::move(other.m_storage.value);
+    else if(!has_value() && !other.has_value())
+      m_storage.error = std::move(other.m_storage.error);
+    else if(other.has_value())
+    {
+      reinit_value(std::move(other.m_storage.value));
+    }
+    else
+    {
+      reinit_error(std::move(other.m_storage.error));
+    }
+
+    return *this;
+  }
+
+  constexpr explicit operator bool() const noexcept { return m_storage.engaged; }
+  constexpr bool has_value() const noexcept { return m_storage.engaged; }
+
+  const T& operator*() const & { assert(has_value()); return m_storage.value; }
+  T& operator*() & { assert(has_value()); return m_storage.value; }
+  T&& operator*() && { assert(has_value()); return std::move(m_storage.value); }
+
+  const T* operator->() const { assert(has_value()); return std::addressof(m_storage.value); }
+  T* operator->() { assert(has_value()); return std::addressof(m_storage.value); }
+
+  const T& value() const & { return **this; }
+  T& value() & { return **this; }
+  T&& value() && { return std::move(**this); }
+
+  const E& error() const & { assert(!has_value()); return m_storage.error; }
+  E& error() & { assert(!has_value()); return m_storage.error; }
+  E&& error() && { assert(!has_value()); return std::move(m_storage.error); }
+
+  template<typename U>
+  T value_or(U &&u) const &
+  {
+    if(has_value())
+      return m_storage.value;
+
+    return static_cast<T>(std::forward<U>(u));
+  }
+
+  template<typename U>
+  T value_or(U &&u) &&
+  {
+    if(has_value())
+      return std::move(m_storage.value);
+
+    return static_cast<T>(std::forward<U>(u));
+  }
+
+  // the error is dropped
+  Optional<T> to_optional() const &
+  {
+    if(has_value())
+      return Optional<T>(m_storage.value);
+
+    return Optional<T>();
+  }
+
+  Optional<T> to_optional() &&
+  {
+    if(has_value())
+      return Optional<T>(std::move(m_storage.value));
+
+    return Optional<T>();
+  }
+
+  // f(value) -> U, errors pass through
+  template<typename F>
+  Expected<detail::expected_result_t<F, const T&>, E> transform(F &&f) const &
+  {
+    using Ret = Expected<detail::expected_result_t<F, const T&>, E>;
+    if(has_value())
+      return Ret(std::forward<F>(f)(m_storage.value));
+
+    return Ret(Unexpected<E>(m_storage.error));
+  }
+
+  template<typename F>
+  Expected<detail::expected_result_t<F, T&&>, E> transform(F &&f) &&
+  {
+    using Ret = Expected<detail::expected_result_t<F, T&&>, E>;
+    if(has_value())
+      return Ret(std::forward<F>(f)(std::move(m_storage.value)));
+
+    return Ret(Unexpected<E>(std::move(m_storage.error)));
+  }
+
+  // f(value) -> Expected<U, E>, errors pass through
+  template<typename F>
+  detail::expected_result_t<F, const T&> and_then(F &&f) const &
+  {
+    using Ret = detail::expected_result_t<F, const T&>;
+    static_assert(std::is_same<typename Ret::error_type, E>::value, "and_then has to keep the error type");
+
+    if(has_value())
+      return std::forward<F>(f)(m_storage.value);
+
+    return Ret(Unexpected<E>(m_storage.error));
+  }
+
+  template<typename F>
+  detail::expected_result_t<F, T&&> and_then(F &&f) &&
+  {
+    using Ret = detail::expected_result_t<F, T&&>;
+    static_assert(std::is_same<typename Ret::error_type, E>::value, "and_then has to keep the error type");
+
+    if(has_value())
+      return std::forward<F>(f)(std::move(m_storage.value));
+
+    return Ret(Unexpected<E>(std::move(m_storage.error)));
+  }
+
+  // f(error) -> G, values pass through
+  template<typename F>
+  Expected<T, detail::expected_result_t<F, const E&>> transform_error(F &&f) const &
+  {
+    using Ret = Expected<T, detail::expected_result_t<F, const E&>>;
+    if(has_value())
+      return Ret(m_storage.value);
+
+    return Ret(make_unexpected(std::forward<F>(f)(m_storage.error)));
+  }
+
+  template<typename F>
+  Expected<T, detail::expected_result_t<F, E&&>> transform_error(F &&f) &&
+  {
+    using Ret = Expected<T, detail::expected_result_t<F, E&&>>;
+    if(has_value())
+      return Ret(std::move(m_storage.value));
+
+    return Ret(make_unexpected(std::forward<F>(f)(std::move(m_storage.error))));
+  }
+
+  // f(error) -> Expected<T, G>, values pass through
+  template<typename F>
+  detail::expected_result_t<F, const E&> or_else(F &&f) const &
+  {
+    using Ret = detail::expected_result_t<F, const E&>;
+    static_assert(std::is_same<typename Ret::value_type, T>::value, "or_else has to keep the value type");
+
+    if(has_value())
+      return Ret(m_storage.value);
+
+    return std::forward<F>(f)(m_storage.error);
+  }
+
+  template<typename F>
+  detail::expected_result_t<F, E&&> or_else(F &&f) &&
+  {
+    using Ret = detail::expected_result_t<F, E&&>;
+    static_assert(std::is_same<typename Ret::value_type, T>::value, "or_else has to keep the value type");
+
+    if(has_value())
+      return Ret(std::move(m_storage.value));
+
+    return std::forward<F>(f)(std::move(m_storage.error));
+  }
+
+  friend void swap(Expected<T, E> &lhs, Expected<T, E> &rhs)
+  {
+    if(lhs.has_value() == rhs.has_value())
+    {
+      using std::swap;
+      if(lhs.has_value())
+        swap(lhs.m_storage.value, rhs.m_storage.value);
+      else
+        swap(lhs.m_storage.error, rhs.m_storage.error);
+
+      return;
+    }
+
+    Expected<T, E> &withValue = lhs.has_value() ? lhs : rhs;
+    Expected<T, E> &withError = lhs.has_value() ? rhs : lhs;
+
+    swap_states(withValue, withError, std::is_nothrow_move_constructible<E>{});
+  }
+};
+
+// an empty Optional becomes the given error
+template<typename T, typename G>
+Expected<T, typename std::decay<G>::type> to_expected(const Optional<T> &opt, G &&err)
+{
+  if(opt)
+    return Expected<T, typename std::decay<G>::type>(*opt);
+
+  return make_unexpected(std::forward<G>(err));
+}
+
+template<typename T, typename G>
+Expected<T, typename std::decay<G>::type> to_expected(Optional<T> &&opt, G &&err)
+{
+  if(opt)
+    return Expected<T, typename std::decay<G>::type>(std::move(*opt));
+
+  return make_unexpected(std::forward<G>(err));
+}
+
+#endif
@@ -0,0 +1,278 @@
+/*
+*  MIT License
+*  
+*  Copyright (c) 2025 Pawel Drzycimski
+*  
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*  
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+*  
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*
+*/
+
+#ifndef PDY_LAZY_HPP_
+#define PDY_LAZY_HPP_
+
+#include "Optional.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+/*
+*  Lazy<T, F> holds a generator F and builds T in place out of F() on the first access.
+*  SyncLazy<T, F> does the same with the first access safe to race from many threads.
+*
+*  The payload sits in the same storage Optional<T> uses, so a trivially destructible T
+*  keeps Lazy trivially destructible as long as F is. The generator is kept by value,
+*  a stateless one (captureless lambda, empty functor with a const operator()) takes no space.
+*
+*  auto parsed = make_lazy([&raw] { return parse(raw); });
+*  if(need) use(*parsed);
+*/
+
+namespace detail {
+
+template<typename F, typename = void>
+struct lazy_const_callable : std::false_type {};
+
+template<typename F>
+struct lazy_const_callable<F, decltype(void(std::declval<const F&>()()))> : std::true_type {};
+
+// accessors of a const Lazy run the generator, so it is either an empty functor callable
+// as const (nothing in it a call could modify) or kept mutable
+template<typename F, bool = std::is_empty<F>::value && !__is_final(F) && lazy_const_callable<F>::value>
+class lazy_generator : private F
+{
+public:
+  explicit lazy_generator(F gen)
+    : F(std::move(gen))
+  {}
+
+  F& generator() noexcept { return *this; }
+  const F& generator() const noexcept { return *this; }
+
+  auto call() const -> decltype(std::declval<const F&>()()) { return generator()(); }
+};
+
+template<typename F>
+class lazy_generator<F, false>
+{
+  mutable F m_gen;
+
+public:
+  explicit lazy_generator(F gen)
+    : m_gen(std::move(gen))
+  {}
+
+  F& generator() noexcept { return m_gen; }
+  const F& generator() const noexcept { return m_gen; }
+
+  auto call() const -> decltype(std::declval<F&>()()) { return m_gen(); }
+};
+
+template<typename F>
+using lazy_result_t = typename std::decay<decltype(std::declval<F&>()())>::type;
+
+} // namespace detail
+
+template<typename T, typename F = T(*)()>
+class Lazy final : private detail::lazy_generator<F>
+{
+  using Gen = detail::lazy_generator<F>;
+
+  mutable detail::optional_storage<T> m_storage;
+
+  void compute() const
+  {
+    ::new(static_cast<void*>(std::addressof(m_storage.value))) T(this->call());
+    m_storage.engaged = true;
+  }
+
+public:
+  explicit Lazy(F gen)
+    : Gen(std::move(gen)), m_storage()
+  {}
+
+  Lazy(const Lazy &other)
+    : Gen(other.generator()), m_storage()
+  {
+    if(other.has_value())
+    {
+      ::new(static_cast<void*>(std::addressof(m_storage.value))) T(other.m_storage.value);
+      m_storage.engaged = true;
+    }
+  }
+
+  Lazy(Lazy &&other)
+    : Gen(std::move(other.generator())), m_storage()
+  {
+    if(other.has_value())
+    {
+      ::new(static_cast<void*>(std::addressof(m_storage.value))) T(std::move(other.m_storage.value));
+      m_storage.engaged = true;
+    }
+  }
+
+  Lazy& operator=(const Lazy&) = delete;
+  Lazy& operator=(Lazy&&) = delete;
+
+  ~Lazy() = default;
+
+  const T& operator*() const
+  {
+    if(!m_storage.engaged)
+      compute();
+
+    return m_storage.value;
+  }
+
+  T& operator*()
+  {
+    if(!m_storage.engaged)
+      compute();
+
+    return m_storage.value;
+  }
+
+  const T* operator->() const { return std::addressof(**this); }
+  T* operator->() { return std::addressof(**this); }
+
+  const T& value() const { return **this; }
+  T& value() { return **this; }
+
+  // computed already?
+  constexpr bool has_value() const noexcept { return m_storage.engaged; }
+
+  // the payload if computed already, never runs the generator
+  Optional<const T&> peek() const noexcept
+  {
+    if(!has_value())
+      return {};
+
+    return m_storage.value;
+  }
+
+  // drops the payload, the next access runs the generator again
+  void invalidate() noexcept(detail::is_noexcept_destructible<T>::value)
+  {
+    if(m_storage.engaged)
+      m_storage.value.~T();
+
+    m_storage.engaged = false;
+  }
+
+  // same as invalidate(), for parity with Optional
+  void reset() noexcept(detail::is_noexcept_destructible<T>::value) { invalidate(); }
+};
+
+/*
+*  The first access may race from any number of threads, the generator runs once.
+*  Accessing a computed value costs one acquire load.
+*  invalidate()/reset() must not race with accessors, nor with anyone still holding a reference.
+*/
+template<typename T, typename F = T(*)()>
+class SyncLazy final : private detail::lazy_generator<F>
+{
+  using Gen = detail::lazy_generator<F>;
+
+  mutable detail::optional_storage<T> m_storage;
+  mutable std::atomic<bool> m_ready;
+  mutable std::mutex m_mutex;
+
+  void compute() const
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    if(m_ready.load(std::memory_order_relaxed))
+      return;
+
+    ::new(static_cast<void*>(std::addressof(m_storage.value))) T(this->call());
+    m_storage.engaged = true;
+    m_ready.store(true, std::memory_order_release);
+  }
+
+public:
+  explicit SyncLazy(F gen)
+    : Gen(std::move(gen)), m_storage(), m_ready{false}, m_mutex{}
+  {}
+
+  SyncLazy(const SyncLazy&) = delete;
+  SyncLazy& operator=(const SyncLazy&) = delete;
+
+  ~SyncLazy() = default;
+
+  const T& operator*() const
+  {
+    if(!m_ready.load(std::memory_order_acquire))
+      compute();
+
+    return m_storage.value;
+  }
+
+  T& operator*()
+  {
+    if(!m_ready.load(std::memory_order_acquire))
+      compute();
+
+    return m_storage.value;
+  }
+
+  const T* operator->() const { return std::addressof(**this); }
+  T* operator->() { return std::addressof(**this); }
+
+  const T& value() const { return **this; }
+  T& value() { return **this; }
+
+  bool has_value() const noexcept { return m_ready.load(std::memory_order_acquire); }
+
+  Optional<const T&> peek() const noexcept
+  {
+    if(!has_value())
+      return {};
+
+    return m_storage.value;
+  }
+
+  void invalidate() noexcept(detail::is_noexcept_destructible<T>::value)
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    if(m_storage.engaged)
+      m_storage.value.~T();
+
+    m_storage.engaged = false;
+    m_ready.store(false, std::memory_order_release);
+  }
+
+  void reset() noexcept(detail::is_noexcept_destructible<T>::value) { invalidate(); }
+};
+
+template<typename F>
+Lazy<detail::lazy_result_t<F>, F> make_lazy(F gen)
+{
+  return Lazy<detail::lazy_result_t<F>, F>{std::move(gen)};
+}
+
+#if __cplusplus >= 201703L
+// SyncLazy is not movable, returning it relies on guaranteed copy elision
+template<typename F>
+SyncLazy<detail::lazy_result_t<F>, F> make_sync_lazy(F gen)
+{
+  return SyncLazy<detail::lazy_result_t<F>, F>{std::move(gen)};
+}
+#endif
+
+#endif
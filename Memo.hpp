@@ -0,0 +1,410 @@
+/*
+*  MIT License
+*  
+*  Copyright (c) 2025 Pawel Drzycimski
+*  
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*  
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+*  
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*
+*/
+
+#ifndef PDY_MEMO_HPP_
+#define PDY_MEMO_HPP_
+
+#include "Optional.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/*
+*  Memo<K, V> is a fixed capacity cache for memoizing pure functions.
+*
+*  The table is allocated once, up front: buckets of 8 slots, a key may only live in
+*  the bucket its hash points to. Once a bucket is full, CLOCK picks the slot to evict:
+*  a hit sets the slot's reference bit, the bucket's hand clears set bits while looking
+*  for one that is not set. No allocation happens per entry.
+*
+*  A reference returned by find()/get_or_compute() stays valid until the next insertion,
+*  which may evict it.
+*
+*  ShardedMemo<K, V> splits the capacity over lock striped Memo shards for multi-threaded use,
+*  its lookups return copies.
+*/
+
+struct MemoStats
+{
+  uint64_t hits;
+  uint64_t misses;
+  uint64_t evictions;
+};
+
+namespace detail {
+
+constexpr unsigned MEMO_WAYS = 8;
+
+inline uint64_t memo_mix(size_t hash) noexcept
+{
+  // fibonacci hashing, std::hash of integers is often the identity
+  return static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ull;
+}
+
+inline size_t memo_round_up_pow2(size_t val) noexcept
+{
+  size_t ret = 1;
+  while(ret < val)
+    ret <<= 1;
+
+  return ret;
+}
+
+constexpr unsigned MEMO_TAG_BITS = 8;
+constexpr unsigned MEMO_SHARD_BITS = 32;
+
+// log2 of the bucket count Memo allocates for 'capacity'
+inline unsigned memo_bucket_bits(size_t capacity) noexcept
+{
+  unsigned bits = 0;
+  for(size_t b = memo_round_up_pow2((capacity + MEMO_WAYS - 1) / MEMO_WAYS); b > 1; b >>= 1)
+    ++bits;
+
+  return bits;
+}
+
+// Low bits of a multiplicative hash depend on the low bits of the key only, so the mixed
+// hash is consumed from the top: the bucket index, the tag right below it and below that
+// the bits ShardedMemo picks its shard with.
+inline uint8_t memo_tag(uint64_t mixed, unsigned bucketBits) noexcept
+{
+  const unsigned used = bucketBits + MEMO_TAG_BITS;
+  return static_cast<uint8_t>(mixed >> (used < 64 ? 64 - used : 0));
+}
+
+inline size_t memo_shard(uint64_t mixed, unsigned bucketBits, size_t shards) noexcept
+{
+  const unsigned used = bucketBits + MEMO_TAG_BITS + MEMO_SHARD_BITS;
+  const uint64_t bits = (mixed >> (used < 64 ? 64 - used : 0)) & 0xFFFFFFFFull;
+
+  // multiply and shift maps the 32 bits onto [0, shards) without a division
+  return static_cast<size_t>((bits * shards) >> MEMO_SHARD_BITS);
+}
+
+} // namespace detail
+
+template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class Memo
+{
+  struct Entry
+  {
+    K key;
+    V value;
+  };
+
+  struct Bucket
+  {
+    uint8_t tags[detail::MEMO_WAYS];
+    uint8_t referenced;
+    uint8_t hand;
+    Optional<Entry> entries[detail::MEMO_WAYS];
+  };
+
+  std::unique_ptr<Bucket[]> m_buckets;
+  size_t m_bucketMask;
+  unsigned m_bucketShift;
+  size_t m_size;
+  MemoStats m_stats;
+  Hash m_hash;
+  KeyEqual m_equal;
+
+  struct Location
+  {
+    Bucket *bucket;
+    uint8_t tag;
+  };
+
+  Location locate(const K &key) const noexcept
+  {
+    const uint64_t mixed = detail::memo_mix(m_hash(key));
+    const size_t idx = m_bucketShift == 64 ? 0 : static_cast<size_t>(mixed >> m_bucketShift);
+    return {&m_buckets[idx & m_bucketMask], detail::memo_tag(mixed, 64 - m_bucketShift)};
+  }
+
+  Entry* lookup(const Location &loc, const K &key) const noexcept
+  {
+    Bucket &bucket = *loc.bucket;
+    for(unsigned way = 0; way < detail::MEMO_WAYS; ++way)
+    {
+      if(bucket.tags[way] == loc.tag && bucket.entries[way] && m_equal(bucket.entries[way]->key, key))
+      {
+        bucket.referenced = static_cast<uint8_t>(bucket.referenced | (1u << way));
+        return &*bucket.entries[way];
+      }
+    }
+
+    return nullptr;
+  }
+
+  unsigned victim(Bucket &bucket) noexcept
+  {
+    for(unsigned way = 0; way < detail::MEMO_WAYS; ++way)
+    {
+      if(!bucket.entries[way])
+        return way;
+    }
+
+    while(bucket.referenced & (1u << bucket.hand))
+    {
+      bucket.referenced = static_cast<uint8_t>(bucket.referenced & ~(1u << bucket.hand));
+      bucket.hand = static_cast<uint8_t>((bucket.hand + 1) % detail::MEMO_WAYS);
+    }
+
+    const unsigned way = bucket.hand;
+    bucket.hand = static_cast<uint8_t>((bucket.hand + 1) % detail::MEMO_WAYS);
+    bucket.entries[way].reset();
+    --m_size;
+    ++m_stats.evictions;
+    return way;
+  }
+
+  template<typename U>
+  V& insert_at(const Location &loc, const K &key, U &&value)
+  {
+    Bucket &bucket = *loc.bucket;
+    const unsigned way = victim(bucket);
+
+    bucket.entries[way] = Entry{key, std::forward<U>(value)};
+    bucket.tags[way] = loc.tag;
+    // a new entry starts unreferenced, it has to earn its second chance
+    bucket.referenced = static_cast<uint8_t>(bucket.referenced & ~(1u << way));
+    ++m_size;
+    return bucket.entries[way]->value;
+  }
+
+public:
+  explicit Memo(size_t capacity, const Hash &hash = Hash{}, const KeyEqual &equal = KeyEqual{})
+    : m_buckets{}, m_bucketMask{0}, m_bucketShift{64}, m_size{0}, m_stats{0, 0, 0}, m_hash(hash), m_equal(equal)
+  {
+    const unsigned bucketBits = detail::memo_bucket_bits(capacity);
+    const size_t buckets = size_t{1} << bucketBits;
+
+    m_buckets.reset(new Bucket[buckets]());
+    m_bucketMask = buckets - 1;
+    m_bucketShift = 64 - bucketBits;
+  }
+
+  Memo(const Memo&) = delete;
+  Memo& operator=(const Memo&) = delete;
+  Memo(Memo&&) = default;
+  Memo& operator=(Memo&&) = default;
+
+  Optional<V&> find(const K &key)
+  {
+    Entry *entry = lookup(locate(key), key);
+    if(!entry)
+    {
+      ++m_stats.misses;
+      return {};
+    }
+
+    ++m_stats.hits;
+    return entry->value;
+  }
+
+  // fn(key) runs on a miss only, it may recurse into this Memo (think fibonacci)
+  template<typename Fn>
+  V& get_or_compute(const K &key, Fn &&fn)
+  {
+    if(Entry *entry = lookup(locate(key), key))
+    {
+      ++m_stats.hits;
+      return entry->value;
+    }
+
+    ++m_stats.misses;
+    return insert(key, fn(key));
+  }
+
+  // inserts or overwrites, may evict
+  template<typename U>
+  V& insert(const K &key, U &&value)
+  {
+    const Location loc = locate(key);
+    if(Entry *entry = lookup(loc, key))
+    {
+      entry->value = std::forward<U>(value);
+      return entry->value;
+    }
+
+    return insert_at(loc, key, std::forward<U>(value));
+  }
+
+  bool erase(const K &key)
+  {
+    const Location loc = locate(key);
+    Bucket &bucket = *loc.bucket;
+    for(unsigned way = 0; way < detail::MEMO_WAYS; ++way)
+    {
+      if(bucket.tags[way] == loc.tag && bucket.entries[way] && m_equal(bucket.entries[way]->key, key))
+      {
+        bucket.entries[way].reset();
+        --m_size;
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  void clear()
+  {
+    for(size_t b = 0; b <= m_bucketMask; ++b)
+    {
+      for(auto &entry : m_buckets[b].entries)
+        entry.reset();
+
+      m_buckets[b].referenced = 0;
+    }
+
+    m_size = 0;
+  }
+
+  size_t size() const noexcept { return m_size; }
+  size_t capacity() const noexcept { return (m_bucketMask + 1) * detail::MEMO_WAYS; }
+
+  const MemoStats& stats() const noexcept { return m_stats; }
+  void reset_stats() noexcept { m_stats = MemoStats{0, 0, 0}; }
+};
+
+template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class ShardedMemo
+{
+  struct alignas(64) Shard
+  {
+    std::mutex mutex;
+    Memo<K, V, Hash, KeyEqual> memo;
+
+    Shard(size_t capacity, const Hash &hash, const KeyEqual &equal)
+      : mutex{}, memo{capacity, hash, equal}
+    {}
+  };
+
+  std::vector<std::unique_ptr<Shard>> m_shards;
+  unsigned m_bucketBits;
+  Hash m_hash;
+
+  Shard& shard_for(const K &key) const noexcept
+  {
+    // bits below the ones every shard's Memo takes its bucket and tag from
+    const uint64_t mixed = detail::memo_mix(m_hash(key));
+    return *m_shards[detail::memo_shard(mixed, m_bucketBits, m_shards.size())];
+  }
+
+public:
+  ShardedMemo(size_t capacity, size_t shards = 16, const Hash &hash = Hash{}, const KeyEqual &equal = KeyEqual{})
+    : m_shards{}, m_bucketBits{0}, m_hash(hash)
+  {
+    assert(shards > 0);
+
+    const size_t perShard = (capacity + shards - 1) / shards;
+    m_bucketBits = detail::memo_bucket_bits(perShard);
+
+    m_shards.reserve(shards);
+    for(size_t s = 0; s < shards; ++s)
+      m_shards.emplace_back(new Shard(perShard, hash, equal));
+  }
+
+  Optional<V> find(const K &key)
+  {
+    Shard &shard = shard_for(key);
+    std::lock_guard<std::mutex> lock{shard.mutex};
+
+    const auto found = shard.memo.find(key);
+    if(!found)
+      return {};
+
+    return *found;
+  }
+
+  // fn(key) runs outside of the lock, two threads missing on the same key may both compute it
+  template<typename Fn>
+  V get_or_compute(const K &key, Fn &&fn)
+  {
+    Shard &shard = shard_for(key);
+    {
+      std::lock_guard<std::mutex> lock{shard.mutex};
+      const auto found = shard.memo.find(key);
+      if(found)
+        return *found;
+    }
+
+    V value = fn(key);
+
+    std::lock_guard<std::mutex> lock{shard.mutex};
+    return shard.memo.insert(key, std::move(value));
+  }
+
+  template<typename U>
+  void insert(const K &key, U &&value)
+  {
+    Shard &shard = shard_for(key);
+    std::lock_guard<std::mutex> lock{shard.mutex};
+    shard.memo.insert(key, std::forward<U>(value));
+  }
+
+  bool erase(const K &key)
+  {
+    Shard &shard = shard_for(key);
+    std::lock_guard<std::mutex> lock{shard.mutex};
+    return shard.memo.erase(key);
+  }
+
+  size_t size() const
+  {
+    size_t ret = 0;
+    for(const auto &shard : m_shards)
+    {
+      std::lock_guard<std::mutex> lock{shard->mutex};
+      ret += shard->memo.size();
+    }
+
+    return ret;
+  }
+
+  size_t capacity() const noexcept { return m_shards.size() * m_shards.front()->memo.capacity(); }
+
+  MemoStats stats() const
+  {
+    MemoStats ret{0, 0, 0};
+    for(const auto &shard : m_shards)
+    {
+      std::lock_guard<std::mutex> lock{shard->mutex};
+      const MemoStats &stats = shard->memo.stats();
+      ret.hits += stats.hits;
+      ret.misses += stats.misses;
+      ret.evictions += stats.evictions;
+    }
+
+    return ret;
+  }
+};
+
+#endif
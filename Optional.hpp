@@ -92,6 +92,14 @@ struct is_noexcept_copy_constructible
   static constexpr bool value = noexcept(NonConst_T(declval<NonConst_T&>())); 
 };
 
+// false rather than a hard error for T without the assignment, so that asking whether
+// Optional<T> is assignable (std::vector does) compiles for such T
+template<typename T>
+struct is_noexcept_copy_assignable : std::is_nothrow_copy_assignable<non_const_t<T>> {};
+
+template<typename T>
+struct is_noexcept_move_assignable : std::is_nothrow_move_assignable<non_const_t<T>> {};
+
 template<typename T>
 struct is_trivially_destructible : std::is_trivially_destructible<T> {};
 
@@ -121,6 +129,26 @@ struct is_noexcept_destructible
 {};
 #endif
 
+// keeps the converting operator= away from Optional<T> arguments, one partial specialization
+// match per call where enable_if over decay and is_same instantiates three templates
+template<typename U, typename Self>
+struct enable_if_not_self
+{
+  using type = void;
+};
+
+template<typename Self>
+struct enable_if_not_self<Self, Self> {};
+
+template<typename Self>
+struct enable_if_not_self<Self&, Self> {};
+
+template<typename Self>
+struct enable_if_not_self<const Self, Self> {};
+
+template<typename Self>
+struct enable_if_not_self<const Self&, Self> {};
+
 template<typename T>
 struct is_arithmetic : std::is_arithmetic<T> {};
 
@@ -149,8 +177,22 @@ struct AddArrowOperator<false, T, TSelf>
   T* operator->() { return &(static_cast<TSelf*>(this)->value()); }
 };
 
+// hot/cold layout choice: with the flag after the payload, has_value() of a large T reads
+// a cache line the start of the value is not on. Specializing this to true puts the flag at
+// offset 0 instead, sizeof stays the same as the padding only moves.
+//
+// template<> struct detail::optional_flag_first<Record> : std::true_type {};
+//
+// has to be visible before Optional<Record> is first used
 template<typename T>
-struct storage_trivial_dtor
+struct optional_flag_first : std::false_type {};
+
+// single template keyed on the destructor triviality, so selecting the storage
+// does not cost a separate conditional_type instantiation per Optional<T>
+template<typename T,
+  bool TrivialDtor = std::is_trivially_destructible<T>::value,
+  bool FlagFirst = optional_flag_first<T>::value>
+struct storage
 {
   union {
     char dummy;
@@ -159,23 +201,23 @@ struct storage_trivial_dtor
 
   bool engaged;
 
-  explicit constexpr storage_trivial_dtor() noexcept
+  explicit constexpr storage() noexcept
     : dummy{0}, engaged{false}
   {}
 
-  explicit constexpr storage_trivial_dtor(const T &val) noexcept
+  explicit constexpr storage(const T &val) noexcept
     : value{val}, engaged{true}
   {}
 
-  explicit constexpr storage_trivial_dtor(T &&val) noexcept
+  explicit constexpr storage(T &&val) noexcept
     : value{std::move(val)}, engaged{true}
   {}
 
-  ~storage_trivial_dtor() = default;
+  ~storage() = default;
 };
 
 template<typename T>
-struct storage_non_trivial_dtor
+struct storage<T, false, false>
 {
   union {
     char dummy;
@@ -184,19 +226,73 @@ struct storage_non_trivial_dtor
 
   bool engaged;
 
-  explicit constexpr storage_non_trivial_dtor() noexcept
+  explicit constexpr storage() noexcept
     : dummy{0}, engaged{false}
   {}
 
-  explicit constexpr storage_non_trivial_dtor(const T &val) noexcept
+  explicit constexpr storage(const T &val) noexcept
     : value{val}, engaged{true}
   {}
 
-  explicit constexpr storage_non_trivial_dtor(T &&val) noexcept
+  explicit constexpr storage(T &&val) noexcept
     : value{std::move(val)}, engaged{true}
   {}
   
-  ~storage_non_trivial_dtor() noexcept(is_noexcept_destructible<T>::value)
+  ~storage() noexcept(is_noexcept_destructible<T>::value)
+  {
+    if(engaged)
+      value.T::~T();
+  }
+};
+
+template<typename T>
+struct storage<T, true, true>
+{
+  bool engaged;
+
+  union {
+    char dummy;
+    T value;
+  };
+
+  explicit constexpr storage() noexcept
+    : engaged{false}, dummy{0}
+  {}
+
+  explicit constexpr storage(const T &val) noexcept
+    : engaged{true}, value{val}
+  {}
+
+  explicit constexpr storage(T &&val) noexcept
+    : engaged{true}, value{std::move(val)}
+  {}
+
+  ~storage() = default;
+};
+
+template<typename T>
+struct storage<T, false, true>
+{
+  bool engaged;
+
+  union {
+    char dummy;
+    T value;
+  };
+
+  explicit constexpr storage() noexcept
+    : engaged{false}, dummy{0}
+  {}
+
+  explicit constexpr storage(const T &val) noexcept
+    : engaged{true}, value{val}
+  {}
+
+  explicit constexpr storage(T &&val) noexcept
+    : engaged{true}, value{std::move(val)}
+  {}
+
+  ~storage() noexcept(is_noexcept_destructible<T>::value)
   {
     if(engaged)
       value.T::~T();
@@ -204,16 +300,23 @@ struct storage_non_trivial_dtor
 };
 
 template<typename T>
-using optional_storage = typename conditional_type<
-    is_trivially_destructible<non_const_t<T>>::value,
-    storage_trivial_dtor<non_const_t<T>>,
-    storage_non_trivial_dtor<non_const_t<T>>>::type;
+using storage_trivial_dtor = storage<T, true>;
+
+template<typename T>
+using storage_non_trivial_dtor = storage<T, false>;
+
+template<typename T>
+using optional_storage = storage<non_const_t<T>>;
+
+struct optional_access;
 
 } // namespace detail
 
 template<typename T>
 class Optional final : public detail::AddArrowOperator<detail::is_arithmetic<T>::value, T, Optional<T>>
 {
+  friend struct detail::optional_access;
+
   detail::optional_storage<T> m_storage;
 
   constexpr const T* get() const { return std::addressof(m_storage.value); }
@@ -252,7 +355,7 @@ public:
     : m_storage()
   {
     if(other.has_value())
-      construct(*other);
+      construct(std::move(*other));
   }
 
   ~Optional() = default;
@@ -279,8 +382,9 @@ public:
     return std::forward<U>(u);
   }
 
+  // by value like the const& overload, a T&& would dangle whenever the fallback is taken
   template<typename U = detail::non_const_t<T>>
-  T&& value_or(U &&u) &&
+  T value_or(U &&u) &&
   {
     if(has_value())
       return std::move(**this);
@@ -296,7 +400,7 @@ public:
     m_storage.engaged = false;
   }
 
-  template<typename U = T>
+  template<typename U = T, typename = typename detail::enable_if_not_self<U, Optional<T>>::type>
   Optional<T>& operator=(U &&val)
   {
     if(has_value())
@@ -307,9 +411,32 @@ public:
     return *this;
   }
 
-  Optional<T>& operator=(Optional<T> other) noexcept(detail::is_noexcept_swappable<Optional<T>>::value)
+  // both engaged: T's own assignment, so e.g. vector's capacity gets reused
+  // only other engaged: construct in place
+  // only this engaged: reset
+  Optional<T>& operator=(const Optional<T> &other)
+    noexcept(detail::is_noexcept_copy_constructible<T>::value && detail::is_noexcept_copy_assignable<T>::value)
   {
-    swap(*this, other);
+    if(has_value() && other.has_value())
+      m_storage.value = *other;
+    else if(other.has_value())
+      construct(*other);
+    else
+      reset();
+
+    return *this;
+  }
+
+  Optional<T>& operator=(Optional<T> &&other)
+    noexcept(detail::is_noxcept_move_constructible<T>::value && detail::is_noexcept_move_assignable<T>::value)
+  {
+    if(has_value() && other.has_value())
+      m_storage.value = std::move(*other);
+    else if(other.has_value())
+      construct(std::move(*other));
+    else
+      reset();
+
     return *this;
   }
 
@@ -333,4 +460,69 @@ public:
   }  
 };
 
+// optional reference, backed by a pointer so it costs no engaged flag,
+// assignment rebinds instead of assigning through
+template<typename T>
+class Optional<T&> final
+{
+  T *m_ptr;
+
+public:
+  constexpr Optional() noexcept
+    : m_ptr{nullptr}
+  {}
+
+  Optional(T &ref) noexcept
+    : m_ptr{std::addressof(ref)}
+  {}
+
+  // would dangle right away
+  Optional(T &&) = delete;
+
+  Optional(const Optional<T&> &other) = default;
+  Optional<T&>& operator=(const Optional<T&> &other) = default;
+  ~Optional() = default;
+
+  T& operator*() const { assert(has_value()); return *m_ptr; }
+  T* operator->() const { assert(has_value()); return m_ptr; }
+
+  constexpr explicit operator bool() const noexcept { return m_ptr != nullptr; }
+  constexpr bool has_value() const noexcept { return m_ptr != nullptr; }
+
+  T& value() const { return **this; }
+
+  template<typename U = detail::non_const_t<T>>
+  detail::non_const_t<T> value_or(U &&u) const
+  {
+    if(has_value())
+      return *m_ptr;
+
+    return std::forward<U>(u);
+  }
+
+  void reset() noexcept { m_ptr = nullptr; }
+
+  friend void swap(Optional<T&> &lhs, Optional<T&> &rhs) noexcept
+  {
+    T *tmp = lhs.m_ptr;
+    lhs.m_ptr = rhs.m_ptr;
+    rhs.m_ptr = tmp;
+  }
+};
+
+namespace detail {
+
+// raw storage access for bulk helpers working on arrays of Optional<T>,
+// bypasses the engaged checks so handle with care
+struct optional_access
+{
+  template<typename T>
+  static optional_storage<T>& storage(Optional<T> &opt) noexcept { return opt.m_storage; }
+
+  template<typename T>
+  static const optional_storage<T>& storage(const Optional<T> &opt) noexcept { return opt.m_storage; }
+};
+
+} // namespace detail
+
 #endif
@@ -0,0 +1,456 @@
+/*
+*  MIT License
+*  
+*  Copyright (c) 2025 Pawel Drzycimski
+*  
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*  
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+*  
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*
+*/
+
+#ifndef PDY_OPTIONAL_ALGORITHM_HPP_
+#define PDY_OPTIONAL_ALGORITHM_HPP_
+
+#include "Optional.hpp"
+#include "OptionalArray.hpp"
+#include "OptionalBitmap.hpp"
+#include "OptionalCompact.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+*  Bulk algorithms over spans of Optional<T> (pointer plus size) and over OptionalArray<T>:
+*
+*    optional_count            number of engaged elements
+*    optional_transform        out[i] = f(*in[i]) for the engaged ones, empty otherwise
+*    optional_reduce           folds the engaged values
+*    optional_transform_reduce folds f(value) of the engaged values
+*    compact                   engaged values gathered into a dense std::vector, with the
+*                              kernels of OptionalCompact.hpp
+*
+*  Every one of them takes an optional execution policy first, SequentialPolicy (the default,
+*  also the reference implementation) or ParallelPolicy{threads}.
+*
+*  The parallel backend cuts the input into one contiguous chunk per thread. optional_transform
+*  puts the boundaries on elements (bitmap words for OptionalArray) of the output that start
+*  a cache line, neighbouring threads then only share a line when an element straddles one,
+*  or when no element of 'out' starts a line at all. The reductions and compact read their
+*  input per chunk and write their own partial, compact's output ranges follow the data and
+*  may share a line at their ends. Inputs below PARALLEL_MIN_ELEMENTS run sequentially.
+*  The caller's thread processes the first chunk.
+*
+*  With ParallelPolicy the reduction op has to be associative and commutative, and the init
+*  value is folded in once: op(Init, Init) and Init(T) (or Init(f(T))) have to be valid,
+*  like for std::reduce. Callables must not throw when run in parallel.
+*/
+
+struct SequentialPolicy {};
+
+struct ParallelPolicy
+{
+  unsigned threads;
+
+  explicit ParallelPolicy(unsigned threadCount = std::thread::hardware_concurrency())
+    : threads{threadCount > 0 ? threadCount : 1}
+  {}
+};
+
+namespace detail {
+
+constexpr size_t PARALLEL_MIN_ELEMENTS = 1 << 14;
+constexpr size_t CACHE_LINE = 64;
+
+constexpr size_t chunk_gcd(size_t a, size_t b) noexcept
+{
+  return b == 0 ? a : chunk_gcd(b, a % b);
+}
+
+// every how many elements of T the element start falls on the same offset within a line
+template<typename T>
+constexpr size_t span_chunk_align() noexcept
+{
+  return CACHE_LINE / chunk_gcd(sizeof(T), CACHE_LINE);
+}
+
+// index of the first element starting a cache line, 0 when none of them ever does
+template<typename T>
+size_t span_line_lead(const T *first) noexcept
+{
+  const uintptr_t addr = reinterpret_cast<uintptr_t>(first);
+  for(size_t i = 0; i < span_chunk_align<T>(); ++i)
+  {
+    if((addr + i * sizeof(T)) % CACHE_LINE == 0)
+      return i;
+  }
+
+  return 0;
+}
+
+// joins the workers started so far, also when starting the next one throws
+struct join_guard
+{
+  std::vector<std::thread> &threads;
+
+  ~join_guard()
+  {
+    for(auto &thread : threads)
+    {
+      if(thread.joinable())
+        thread.join();
+    }
+  }
+};
+
+// f(begin, end, chunkIdx) over [0, count), returns the number of chunks used;
+// boundaries fall on lead + a multiple of align
+template<typename F>
+size_t for_each_chunk(const SequentialPolicy&, size_t count, size_t, F &&f, size_t = 0)
+{
+  f(size_t{0}, count, size_t{0});
+  return 1;
+}
+
+template<typename F>
+size_t for_each_chunk(const ParallelPolicy &policy, size_t count, size_t align, F &&f, size_t lead = 0)
+{
+  if(policy.threads <= 1 || count < PARALLEL_MIN_ELEMENTS)
+  {
+    f(size_t{0}, count, size_t{0});
+    return 1;
+  }
+
+  const size_t perThread = (count + policy.threads - 1) / policy.threads;
+  const size_t chunk = (perThread + align - 1) / align * align;
+  const size_t firstEnd = std::min(count, lead % align + chunk);
+  const size_t chunks = 1 + (count - firstEnd + chunk - 1) / chunk;
+
+  std::vector<std::thread> workers;
+  join_guard guard{workers};
+  workers.reserve(chunks - 1);
+  for(size_t c = 1; c < chunks; ++c)
+  {
+    const size_t begin = firstEnd + (c - 1) * chunk;
+    workers.emplace_back(std::ref(f), begin, std::min(count, begin + chunk), c);
+  }
+
+  f(size_t{0}, firstEnd, size_t{0});
+
+  return chunks;
+}
+
+template<typename Policy>
+size_t max_chunks(const Policy&) noexcept { return 1; }
+
+inline size_t max_chunks(const ParallelPolicy &policy) noexcept { return policy.threads; }
+
+// words [beginWord, endWord) of a bitmap, calls f(index) per set bit
+template<typename F>
+void bitmap_chunk_for_each_set(const uint64_t *words, size_t beginWord, size_t endWord, F &&f)
+{
+  bitmap_for_each_set(words + beginWord, endWord - beginWord, [&](size_t idx) { f(beginWord * 64 + idx); });
+}
+
+// chunkFold fills the partial of its chunk once, at the end, partials of neighbouring chunks share a line
+template<typename Policy, typename Init, typename ChunkFold, typename Op>
+Init combine_partials(const Policy &policy, size_t count, size_t align, Init init, ChunkFold &&chunkFold, Op &&op)
+{
+  std::vector<Optional<Init>> partials(max_chunks(policy));
+  for_each_chunk(policy, count, align, [&](size_t begin, size_t end, size_t chunk) {
+    chunkFold(begin, end, partials[chunk]);
+  });
+
+  for(auto &partial : partials)
+  {
+    if(partial)
+      init = op(std::move(init), std::move(*partial));
+  }
+
+  return init;
+}
+
+template<typename Init, typename Op, typename U>
+void fold_into(Optional<Init> &acc, Op &op, U &&val)
+{
+  if(acc)
+    *acc = op(std::move(*acc), std::forward<U>(val));
+  else
+    acc = Init(std::forward<U>(val));
+}
+
+} // namespace detail
+
+// ---- optional_count
+
+template<typename Policy, typename T>
+size_t optional_count(const Policy &policy, const Optional<T> *first, size_t count)
+{
+  return detail::combine_partials(policy, count, 1, size_t{0},
+    [first](size_t begin, size_t end, Optional<size_t> &partial) {
+      size_t ret = 0;
+      for(size_t i = begin; i < end; ++i)
+        ret += first[i].has_value();
+      partial = ret;
+    },
+    [](size_t lhs, size_t rhs) { return lhs + rhs; });
+}
+
+template<typename Policy, typename T>
+size_t optional_count(const Policy &policy, const OptionalArray<T> &arr)
+{
+  const uint64_t *words = arr.bitmap();
+  return detail::combine_partials(policy, arr.bitmap_size(), detail::CACHE_LINE / sizeof(uint64_t), size_t{0},
+    [words](size_t begin, size_t end, Optional<size_t> &partial) {
+      size_t ret = 0;
+      for(size_t w = begin; w < end; ++w)
+        ret += detail::popcount64(words[w]);
+      partial = ret;
+    },
+    [](size_t lhs, size_t rhs) { return lhs + rhs; });
+}
+
+template<typename T>
+size_t optional_count(const Optional<T> *first, size_t count)
+{
+  return optional_count(SequentialPolicy{}, first, count);
+}
+
+template<typename T>
+size_t optional_count(const OptionalArray<T> &arr)
+{
+  return optional_count(SequentialPolicy{}, arr);
+}
+
+// ---- optional_transform
+
+template<typename Policy, typename T, typename U, typename F>
+void optional_transform(const Policy &policy, const Optional<T> *in, size_t count, Optional<U> *out, F f)
+{
+  detail::for_each_chunk(policy, count, detail::span_chunk_align<Optional<U>>(), [&](size_t begin, size_t end, size_t) {
+    for(size_t i = begin; i < end; ++i)
+    {
+      if(in[i])
+        out[i] = f(*in[i]);
+      else
+        out[i].reset();
+    }
+  }, detail::span_line_lead(out));
+}
+
+// 'out' is resized to the size of 'in', its engaged state becomes the one of 'in'
+template<typename Policy, typename T, typename U, typename F>
+void optional_transform(const Policy &policy, const OptionalArray<T> &in, OptionalArray<U> &out, F f)
+{
+  out.resize(in.size());
+
+  const uint64_t *inWords = in.bitmap();
+  const T *inValues = in.values();
+  uint64_t *outWords = out.bitmap();
+  U *outValues = out.values();
+
+  detail::for_each_chunk(policy, in.bitmap_size(), detail::span_chunk_align<uint64_t>(), [&](size_t begin, size_t end, size_t) {
+    std::copy(inWords + begin, inWords + end, outWords + begin);
+    detail::bitmap_chunk_for_each_set(inWords, begin, end, [&](size_t idx) {
+      outValues[idx] = f(inValues[idx]);
+    });
+  }, detail::span_line_lead(outWords));
+}
+
+template<typename T, typename U, typename F>
+void optional_transform(const Optional<T> *in, size_t count, Optional<U> *out, F f)
+{
+  optional_transform(SequentialPolicy{}, in, count, out, std::move(f));
+}
+
+template<typename T, typename U, typename F>
+void optional_transform(const OptionalArray<T> &in, OptionalArray<U> &out, F f)
+{
+  optional_transform(SequentialPolicy{}, in, out, std::move(f));
+}
+
+// ---- optional_transform_reduce / optional_reduce
+
+template<typename T, typename Init, typename Op, typename F>
+Init optional_transform_reduce(const SequentialPolicy&, const Optional<T> *first, size_t count, Init init, Op op, F f)
+{
+  for(size_t i = 0; i < count; ++i)
+  {
+    if(first[i])
+      init = op(std::move(init), f(*first[i]));
+  }
+
+  return init;
+}
+
+template<typename T, typename Init, typename Op, typename F>
+Init optional_transform_reduce(const ParallelPolicy &policy, const Optional<T> *first, size_t count, Init init, Op op, F f)
+{
+  return detail::combine_partials(policy, count, 1, std::move(init),
+    [&](size_t begin, size_t end, Optional<Init> &partial) {
+      Optional<Init> acc;
+      for(size_t i = begin; i < end; ++i)
+      {
+        if(first[i])
+          detail::fold_into(acc, op, f(*first[i]));
+      }
+      partial = std::move(acc);
+    },
+    op);
+}
+
+template<typename T, typename Init, typename Op, typename F>
+Init optional_transform_reduce(const SequentialPolicy&, const OptionalArray<T> &arr, Init init, Op op, F f)
+{
+  const T *values = arr.values();
+  detail::bitmap_for_each_set(arr.bitmap(), arr.bitmap_size(), [&](size_t idx) {
+    init = op(std::move(init), f(values[idx]));
+  });
+
+  return init;
+}
+
+template<typename T, typename Init, typename Op, typename F>
+Init optional_transform_reduce(const ParallelPolicy &policy, const OptionalArray<T> &arr, Init init, Op op, F f)
+{
+  const uint64_t *words = arr.bitmap();
+  const T *values = arr.values();
+  return detail::combine_partials(policy, arr.bitmap_size(), 1, std::move(init),
+    [&](size_t begin, size_t end, Optional<Init> &partial) {
+      Optional<Init> acc;
+      detail::bitmap_chunk_for_each_set(words, begin, end, [&](size_t idx) {
+        detail::fold_into(acc, op, f(values[idx]));
+      });
+      partial = std::move(acc);
+    },
+    op);
+}
+
+template<typename T, typename Init, typename Op, typename F>
+Init optional_transform_reduce(const Optional<T> *first, size_t count, Init init, Op op, F f)
+{
+  return optional_transform_reduce(SequentialPolicy{}, first, count, std::move(init), std::move(op), std::move(f));
+}
+
+template<typename T, typename Init, typename Op, typename F>
+Init optional_transform_reduce(const OptionalArray<T> &arr, Init init, Op op, F f)
+{
+  return optional_transform_reduce(SequentialPolicy{}, arr, std::move(init), std::move(op), std::move(f));
+}
+
+namespace detail {
+
+struct identity_transform
+{
+  template<typename T>
+  const T& operator()(const T &val) const noexcept { return val; }
+};
+
+} // namespace detail
+
+template<typename Policy, typename T, typename Init, typename Op = std::plus<Init>>
+Init optional_reduce(const Policy &policy, const Optional<T> *first, size_t count, Init init, Op op = Op{})
+{
+  return optional_transform_reduce(policy, first, count, std::move(init), std::move(op), detail::identity_transform{});
+}
+
+template<typename Policy, typename T, typename Init, typename Op = std::plus<Init>>
+Init optional_reduce(const Policy &policy, const OptionalArray<T> &arr, Init init, Op op = Op{})
+{
+  return optional_transform_reduce(policy, arr, std::move(init), std::move(op), detail::identity_transform{});
+}
+
+template<typename T, typename Init, typename Op = std::plus<Init>>
+Init optional_reduce(const Optional<T> *first, size_t count, Init init, Op op = Op{})
+{
+  return optional_reduce(SequentialPolicy{}, first, count, std::move(init), std::move(op));
+}
+
+template<typename T, typename Init, typename Op = std::plus<Init>>
+Init optional_reduce(const OptionalArray<T> &arr, Init init, Op op = Op{})
+{
+  return optional_reduce(SequentialPolicy{}, arr, std::move(init), std::move(op));
+}
+
+// ---- compact
+
+// two passes when parallel: count per chunk, then every chunk writes its own range of the result
+template<typename Policy, typename T>
+std::vector<detail::non_const_t<T>> compact(const Policy &policy, const Optional<T> *first, size_t count)
+{
+  std::vector<size_t> offsets(detail::max_chunks(policy) + 1, 0);
+  detail::for_each_chunk(policy, count, detail::span_chunk_align<Optional<T>>(), [&](size_t begin, size_t end, size_t chunk) {
+    offsets[chunk + 1] = optional_count(SequentialPolicy{}, first + begin, end - begin);
+  });
+
+  for(size_t c = 1; c < offsets.size(); ++c)
+    offsets[c] += offsets[c - 1];
+
+  // the OptionalCompact kernels, each chunk with room for exactly its own engaged values
+  std::vector<detail::non_const_t<T>> ret(offsets.back());
+  detail::for_each_chunk(policy, count, detail::span_chunk_align<Optional<T>>(), [&](size_t begin, size_t end, size_t chunk) {
+    const size_t room = offsets[chunk + 1] - offsets[chunk];
+    if(room > 0)
+      detail::compact_n(first + begin, end - begin, ret.data() + offsets[chunk], nullptr, room);
+  });
+
+  return ret;
+}
+
+template<typename Policy, typename T>
+std::vector<T> compact(const Policy &policy, const OptionalArray<T> &arr)
+{
+  const uint64_t *words = arr.bitmap();
+  const T *values = arr.values();
+
+  std::vector<size_t> offsets(detail::max_chunks(policy) + 1, 0);
+  detail::for_each_chunk(policy, arr.bitmap_size(), 1, [&](size_t begin, size_t end, size_t chunk) {
+    size_t engaged = 0;
+    for(size_t w = begin; w < end; ++w)
+      engaged += detail::popcount64(words[w]);
+    offsets[chunk + 1] = engaged;
+  });
+
+  for(size_t c = 1; c < offsets.size(); ++c)
+    offsets[c] += offsets[c - 1];
+
+  std::vector<T> ret(offsets.back());
+  detail::for_each_chunk(policy, arr.bitmap_size(), 1, [&](size_t begin, size_t end, size_t chunk) {
+    detail::compact_words(words, values, arr.size(), begin, end, ret.data() + offsets[chunk], nullptr);
+  });
+
+  return ret;
+}
+
+template<typename T>
+std::vector<detail::non_const_t<T>> compact(const Optional<T> *first, size_t count)
+{
+  return compact(SequentialPolicy{}, first, count);
+}
+
+template<typename T>
+std::vector<T> compact(const OptionalArray<T> &arr)
+{
+  return compact(SequentialPolicy{}, arr);
+}
+
+#endif
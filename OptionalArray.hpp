@@ -0,0 +1,149 @@
+/*
+*  MIT License
+*  
+*  Copyright (c) 2025 Pawel Drzycimski
+*  
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*  
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+*  
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*
+*/
+
+#ifndef PDY_OPTIONAL_ARRAY_HPP_
+#define PDY_OPTIONAL_ARRAY_HPP_
+
+#include "Optional.hpp"
+#include "OptionalBitmap.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+*  Columnar array of nullable values: a validity bitmap plus one value slot per element.
+*  Empty elements keep a value initialized T in their slot, so T has to be default constructible.
+*
+*  Compared to std::vector<Optional<T>> there is no per element padding and the engaged
+*  state of 64 elements is a single word, which is what the bulk algorithms work on.
+*/
+template<typename T>
+class OptionalArray
+{
+  std::vector<uint64_t> m_words;
+  std::vector<T> m_values;
+
+public:
+  OptionalArray() = default;
+
+  explicit OptionalArray(size_t size)
+    : m_words(detail::bitmap_words(size), 0), m_values(size)
+  {}
+
+  size_t size() const noexcept { return m_values.size(); }
+  bool empty() const noexcept { return m_values.empty(); }
+
+  // new elements are empty
+  void resize(size_t size)
+  {
+    const size_t old = m_values.size();
+    m_values.resize(size);
+    m_words.resize(detail::bitmap_words(size), 0);
+
+    if(size < old && size % 64 != 0)
+      m_words.back() &= (uint64_t{1} << (size % 64)) - 1;
+  }
+
+  void reserve(size_t size)
+  {
+    m_values.reserve(size);
+    m_words.reserve(detail::bitmap_words(size));
+  }
+
+  void clear() noexcept
+  {
+    m_values.clear();
+    m_words.clear();
+  }
+
+  bool has_value(size_t idx) const noexcept
+  {
+    assert(idx < size());
+    return detail::bitmap_test(m_words.data(), idx);
+  }
+
+  Optional<const T&> operator[](size_t idx) const noexcept
+  {
+    if(!has_value(idx))
+      return {};
+
+    return m_values[idx];
+  }
+
+  template<typename U = T>
+  void set(size_t idx, U &&val)
+  {
+    assert(idx < size());
+    m_values[idx] = std::forward<U>(val);
+    m_words[idx / 64] |= uint64_t{1} << (idx % 64);
+  }
+
+  // the slot keeps its last value, it is simply not engaged anymore
+  void reset(size_t idx) noexcept
+  {
+    assert(idx < size());
+    m_words[idx / 64] &= ~(uint64_t{1} << (idx % 64));
+  }
+
+  void push_back(const Optional<T> &opt)
+  {
+    const size_t idx = size();
+    resize(idx + 1);
+    if(opt)
+      set(idx, *opt);
+  }
+
+  template<typename U = T,
+    typename = typename std::enable_if<!std::is_same<typename std::decay<U>::type, Optional<T>>::value>::type>
+  void push_back(U &&val)
+  {
+    const size_t idx = size();
+    resize(idx + 1);
+    set(idx, std::forward<U>(val));
+  }
+
+  // number of engaged elements
+  size_t count() const noexcept
+  {
+    size_t ret = 0;
+    for(const uint64_t word : m_words)
+      ret += detail::popcount64(word);
+
+    return ret;
+  }
+
+  const uint64_t* bitmap() const noexcept { return m_words.data(); }
+  uint64_t* bitmap() noexcept { return m_words.data(); }
+  size_t bitmap_size() const noexcept { return m_words.size(); }
+
+  // one slot per element, meaningful for the engaged ones only
+  const T* values() const noexcept { return m_values.data(); }
+  T* values() noexcept { return m_values.data(); }
+};
+
+#endif
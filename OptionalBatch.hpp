@@ -0,0 +1,225 @@
+/*
+*  MIT License
+*  
+*  Copyright (c) 2025 Pawel Drzycimski
+*  
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*  
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+*  
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*
+*/
+
+#ifndef PDY_OPTIONAL_BATCH_HPP_
+#define PDY_OPTIONAL_BATCH_HPP_
+
+#include "Optional.hpp"
+#include "OptionalArray.hpp"
+#include "OptionalBitmap.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+/*
+*  Whole array operations on Optional<T>, cheaper than a reset() or an assignment per element:
+*
+*    reset_all(first, n)                every element empty
+*    fill_engaged(first, n, value)      every element engaged, holding a copy of value
+*    uninitialized_default_n(first, n)  n empty Optionals constructed in raw memory
+*
+*  With T trivially destructible no destructor has to run, so emptying is a store per flag
+*  and construction is a placement new per element, both of which compile to plain stores.
+*  A whole range memset is only taken for an Optional<T> that is trivially copyable, the one
+*  case where raw bytes may create or overwrite it, and only after an all zero Optional<T>
+*  has been checked to read as empty. Optional<T> defines its own copy operations, so as the
+*  type stands the per element path is the one that runs.
+*  For any other T reset_all gathers 64 flags into a word first and visits the engaged
+*  elements only, the empty ones cost no branch.
+*
+*  The same operations are there for OptionalArray<T>, where they work on the bitmap words.
+*/
+
+namespace detail {
+
+constexpr size_t BATCH_MEMSET_MAX_SIZE = 64;
+
+// raw bytes start an object's lifetime or replace its value only when it is trivially copyable
+template<typename T>
+struct batch_memset : std::integral_constant<bool,
+    std::is_trivially_copyable<Optional<T>>::value && sizeof(Optional<T>) <= BATCH_MEMSET_MAX_SIZE>
+{};
+
+template<typename T>
+bool batch_zero_is_empty() noexcept
+{
+  static_assert(batch_memset<T>::value, "zero bytes are only read back from a trivially copyable Optional");
+
+  Optional<T> probe;
+  const unsigned char zero[sizeof(Optional<T>)] = {};
+  std::memcpy(static_cast<void*>(&probe), zero, sizeof(zero));
+  return !probe.has_value();
+}
+
+template<typename T>
+void batch_zero(Optional<T> *first, size_t n, std::true_type /*memset*/) noexcept
+{
+  assert(batch_zero_is_empty<T>());
+  std::memset(static_cast<void*>(first), 0, n * sizeof(Optional<T>));
+}
+
+template<typename T>
+void batch_default(Optional<T> *first, size_t n, std::false_type /*memset*/) noexcept
+{
+  for(size_t i = 0; i < n; ++i)
+    ::new(static_cast<void*>(first + i)) Optional<T>();
+}
+
+template<typename T>
+void batch_default(Optional<T> *first, size_t n, std::true_type tag) noexcept
+{
+  batch_zero(first, n, tag);
+}
+
+template<typename T>
+void batch_empty_trivial(Optional<T> *first, size_t n, std::false_type /*memset*/) noexcept
+{
+  for(size_t i = 0; i < n; ++i)
+    optional_access::storage(first[i]).engaged = false;
+}
+
+template<typename T>
+void batch_empty_trivial(Optional<T> *first, size_t n, std::true_type tag) noexcept
+{
+  batch_zero(first, n, tag);
+}
+
+// flags of first[0, count), count <= 64, branch free
+template<typename T>
+uint64_t batch_engaged_word(const Optional<T> *first, size_t count) noexcept
+{
+  uint64_t word = 0;
+  for(size_t i = 0; i < count; ++i)
+    word |= static_cast<uint64_t>(optional_access::storage(first[i]).engaged) << i;
+
+  return word;
+}
+
+template<typename T>
+void batch_construct(Optional<T> &opt, const T &value)
+{
+  auto &storage = optional_access::storage(opt);
+  ::new(static_cast<void*>(std::addressof(storage.value))) T(value);
+  storage.engaged = true;
+}
+
+template<typename T>
+void batch_refill(Optional<T> &opt, const T &value, std::true_type /*assignable*/)
+{
+  optional_access::storage(opt).value = value;
+}
+
+template<typename T>
+void batch_refill(Optional<T> &opt, const T &value, std::false_type /*assignable*/)
+{
+  opt.reset();
+  batch_construct(opt, value);
+}
+
+} // namespace detail
+
+template<typename T>
+void uninitialized_default_n(Optional<T> *first, size_t n) noexcept
+{
+  if(n == 0)
+    return;
+
+  detail::batch_default(first, n, detail::batch_memset<T>{});
+}
+
+template<typename T>
+void reset_all(Optional<T> *first, size_t n) noexcept(detail::is_noexcept_destructible<T>::value)
+{
+  if(n == 0)
+    return;
+
+  if(std::is_trivially_destructible<T>::value)
+  {
+    detail::batch_empty_trivial(first, n, detail::batch_memset<T>{});
+    return;
+  }
+
+  for(size_t base = 0; base < n; base += 64)
+  {
+    const size_t count = n - base < 64 ? n - base : 64;
+    for(uint64_t bits = detail::batch_engaged_word(first + base, count); bits != 0; bits &= bits - 1)
+      first[base + detail::ctz64(bits)].reset();
+  }
+}
+
+// T's own assignment where an element is engaged already (destroy and construct when T has none),
+// copy construction elsewhere
+template<typename T>
+void fill_engaged(Optional<T> *first, size_t n, const T &value)
+{
+  if(std::is_trivially_copyable<T>::value)
+  {
+    // overwriting a trivial value needs no destructor, nor the old flag
+    for(size_t i = 0; i < n; ++i)
+    {
+      auto &storage = detail::optional_access::storage(first[i]);
+      std::memcpy(static_cast<void*>(std::addressof(storage.value)), static_cast<const void*>(std::addressof(value)), sizeof(T));
+      storage.engaged = true;
+    }
+
+    return;
+  }
+
+  for(size_t i = 0; i < n; ++i)
+  {
+    if(first[i])
+      detail::batch_refill(first[i], value, std::is_copy_assignable<T>{});
+    else
+      detail::batch_construct(first[i], value);
+  }
+}
+
+// slots keep their last values, as OptionalArray::reset does
+template<typename T>
+void reset_all(OptionalArray<T> &arr) noexcept
+{
+  if(arr.bitmap_size() != 0)
+    std::memset(arr.bitmap(), 0, arr.bitmap_size() * sizeof(uint64_t));
+}
+
+template<typename T>
+void fill_engaged(OptionalArray<T> &arr, const T &value)
+{
+  std::fill(arr.values(), arr.values() + arr.size(), value);
+
+  if(arr.bitmap_size() == 0)
+    return;
+
+  std::memset(arr.bitmap(), 0xFF, arr.bitmap_size() * sizeof(uint64_t));
+  if(arr.size() % 64 != 0)
+    arr.bitmap()[arr.bitmap_size() - 1] = (uint64_t{1} << (arr.size() % 64)) - 1;
+}
+
+#endif
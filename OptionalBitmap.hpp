@@ -0,0 +1,123 @@
+/*
+*  MIT License
+*  
+*  Copyright (c) 2025 Pawel Drzycimski
+*  
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*  
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+*  
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*
+*/
+
+#ifndef PDY_OPTIONAL_BITMAP_HPP_
+#define PDY_OPTIONAL_BITMAP_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// validity bitmap helpers shared by the columnar containers,
+// element i lives in bit (i % 64) of word (i / 64)
+
+namespace detail {
+
+inline unsigned popcount64(uint64_t word) noexcept
+{
+  return static_cast<unsigned>(__builtin_popcountll(word));
+}
+
+// undefined for 0
+inline unsigned ctz64(uint64_t word) noexcept
+{
+  return static_cast<unsigned>(__builtin_ctzll(word));
+}
+
+constexpr size_t bitmap_words(size_t count) noexcept
+{
+  return (count + 63) / 64;
+}
+
+inline bool bitmap_test(const uint64_t *words, size_t idx) noexcept
+{
+  return (words[idx / 64] >> (idx % 64)) & 1u;
+}
+
+// calls f(index) for every set bit, in order
+template<typename F>
+void bitmap_for_each_set(const uint64_t *words, size_t wordCount, F &&f)
+{
+  for(size_t w = 0; w < wordCount; ++w)
+  {
+    uint64_t bits = words[w];
+    while(bits != 0)
+    {
+      f(w * 64 + ctz64(bits));
+      bits &= bits - 1;
+    }
+  }
+}
+
+// rank directory: number of set bits before every 512 bit block,
+// rank(i) is then a lookup plus at most 7 full and one partial popcount
+class bitmap_rank
+{
+  static constexpr size_t WORDS_PER_BLOCK = 8;
+
+  std::vector<uint64_t> m_blocks;
+
+public:
+  void build(const uint64_t *words, size_t wordCount)
+  {
+    m_blocks.assign((wordCount + WORDS_PER_BLOCK - 1) / WORDS_PER_BLOCK + 1, 0);
+
+    uint64_t total = 0;
+    for(size_t w = 0; w < wordCount; ++w)
+    {
+      if(w % WORDS_PER_BLOCK == 0)
+        m_blocks[w / WORDS_PER_BLOCK] = total;
+
+      total += popcount64(words[w]);
+    }
+
+    m_blocks.back() = total;
+  }
+
+  // set bits in [0, idx)
+  uint64_t rank(const uint64_t *words, size_t idx) const noexcept
+  {
+    const size_t word = idx / 64;
+    const size_t block = word / WORDS_PER_BLOCK;
+
+    uint64_t ret = m_blocks[block];
+    for(size_t w = block * WORDS_PER_BLOCK; w < word; ++w)
+      ret += popcount64(words[w]);
+
+    const unsigned bit = static_cast<unsigned>(idx % 64);
+    if(bit != 0)
+      ret += popcount64(words[word] << (64 - bit));
+
+    return ret;
+  }
+
+  uint64_t total() const noexcept { return m_blocks.empty() ? 0 : m_blocks.back(); }
+
+  size_t memory_usage() const noexcept { return m_blocks.capacity() * sizeof(uint64_t); }
+};
+
+} // namespace detail
+
+#endif
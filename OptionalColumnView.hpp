@@ -0,0 +1,248 @@
+/*
+*  MIT License
+*  
+*  Copyright (c) 2025 Pawel Drzycimski
+*  
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*  
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+*  
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*
+*/
+
+#ifndef PDY_OPTIONAL_COLUMN_VIEW_HPP_
+#define PDY_OPTIONAL_COLUMN_VIEW_HPP_
+
+#include "Optional.hpp"
+#include "OptionalBitmap.hpp"
+#include "OptionalSerialize.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+*  Read-only view over one block written by OptionalWriter (see OptionalSerialize.hpp),
+*  either mmapped from a file or attached to memory the caller keeps alive.
+*
+*  Nothing is parsed or copied: elements and engaged values are read straight from
+*  the mapped pages, so worker processes mapping the same file share the page cache.
+*  The only work done on open is a pass over the bitmap to build the rank directory
+*  used by the random access operator[].
+*
+*  POSIX only. The block is read in place, which requires a little-endian host.
+*/
+
+template<typename T>
+class OptionalColumnView
+{
+  static_assert(std::is_trivially_copyable<T>::value, "column payload has to be trivially copyable");
+
+  const unsigned char *m_mapping;
+  size_t m_mappingSize;
+
+  const uint64_t *m_words;
+  const T *m_values;
+  size_t m_size;
+  detail::bitmap_rank m_rank;
+
+  void unmap() noexcept
+  {
+    if(m_mapping)
+      ::munmap(const_cast<unsigned char*>(m_mapping), m_mappingSize);
+
+    m_mapping = nullptr;
+    m_mappingSize = 0;
+  }
+
+  bool bind(const unsigned char *block, size_t available) noexcept
+  {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    (void)block;
+    (void)available;
+    return false;
+#else
+    detail::serial_header header;
+    if(available < detail::SERIAL_HEADER_SIZE
+        || reinterpret_cast<uintptr_t>(block) % detail::serial_alignment<T>() != 0
+        || !detail::serial_decode_header(block, header)
+        || header.valueSize != sizeof(T))
+      return false;
+
+    if(header.count / 64 > available / 8)
+      return false;
+
+    const uint64_t wordCount = detail::serial_bitmap_words(header.count);
+    const uint64_t valuesOffset = detail::serial_values_offset<T>(header.count);
+    if(valuesOffset > available)
+      return false;
+
+    const auto *words = reinterpret_cast<const uint64_t*>(block + detail::SERIAL_HEADER_SIZE);
+    if(wordCount > 0 && !detail::serial_valid_tail(words[wordCount - 1], header.count))
+      return false;
+
+    detail::bitmap_rank rank;
+    rank.build(words, static_cast<size_t>(wordCount));
+    if(rank.total() > (available - valuesOffset) / sizeof(T))
+      return false;
+
+    m_words = words;
+    m_values = reinterpret_cast<const T*>(block + valuesOffset);
+    m_size = static_cast<size_t>(header.count);
+    m_rank = std::move(rank);
+    return true;
+#endif
+  }
+
+public:
+  OptionalColumnView() noexcept
+    : m_mapping{nullptr}, m_mappingSize{0}, m_words{nullptr}, m_values{nullptr}, m_size{0}, m_rank{}
+  {}
+
+  OptionalColumnView(const OptionalColumnView&) = delete;
+  OptionalColumnView& operator=(const OptionalColumnView&) = delete;
+
+  OptionalColumnView(OptionalColumnView &&other) noexcept
+    : OptionalColumnView{}
+  {
+    swap(*this, other);
+  }
+
+  OptionalColumnView& operator=(OptionalColumnView &&other) noexcept
+  {
+    OptionalColumnView tmp{std::move(other)};
+    swap(*this, tmp);
+    return *this;
+  }
+
+  ~OptionalColumnView()
+  {
+    unmap();
+  }
+
+  // maps the whole file, 'offset' is where the block starts, as given by OptionalWriter::offset()
+  bool open(const char *path, uint64_t offset = 0) noexcept
+  {
+    close();
+
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if(fd < 0)
+      return false;
+
+    struct stat st;
+    if(::fstat(fd, &st) != 0 || st.st_size <= 0 || static_cast<uint64_t>(st.st_size) < offset)
+    {
+      ::close(fd);
+      return false;
+    }
+
+    const auto size = static_cast<size_t>(st.st_size);
+    void *mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if(mapping == MAP_FAILED)
+      return false;
+
+    m_mapping = static_cast<const unsigned char*>(mapping);
+    m_mappingSize = size;
+
+    if(!bind(m_mapping + offset, size - static_cast<size_t>(offset)))
+    {
+      close();
+      return false;
+    }
+
+    return true;
+  }
+
+  // views a block in memory owned by the caller
+  bool attach(const void *block, size_t size) noexcept
+  {
+    close();
+
+    if(!bind(static_cast<const unsigned char*>(block), size))
+    {
+      close();
+      return false;
+    }
+
+    return true;
+  }
+
+  void close() noexcept
+  {
+    unmap();
+    m_words = nullptr;
+    m_values = nullptr;
+    m_size = 0;
+    m_rank = detail::bitmap_rank{};
+  }
+
+  bool is_open() const noexcept { return m_values != nullptr; }
+
+  size_t size() const noexcept { return m_size; }
+
+  // number of engaged elements
+  size_t count() const noexcept { return static_cast<size_t>(m_rank.total()); }
+
+  bool has_value(size_t idx) const noexcept
+  {
+    assert(idx < m_size);
+    return detail::bitmap_test(m_words, idx);
+  }
+
+  Optional<const T&> operator[](size_t idx) const noexcept
+  {
+    if(!has_value(idx))
+      return {};
+
+    return m_values[m_rank.rank(m_words, idx)];
+  }
+
+  // engaged values only, densely packed in element order
+  const T* values() const noexcept { return m_values; }
+
+  const uint64_t* bitmap() const noexcept { return m_words; }
+
+  // f(index, value) for every engaged element, in order
+  template<typename F>
+  void for_each_engaged(F &&f) const
+  {
+    const T *value = m_values;
+    detail::bitmap_for_each_set(m_words, detail::bitmap_words(m_size), [&](size_t idx) {
+      f(idx, *value++);
+    });
+  }
+
+  friend void swap(OptionalColumnView &lhs, OptionalColumnView &rhs) noexcept
+  {
+    using std::swap;
+    swap(lhs.m_mapping, rhs.m_mapping);
+    swap(lhs.m_mappingSize, rhs.m_mappingSize);
+    swap(lhs.m_words, rhs.m_words);
+    swap(lhs.m_values, rhs.m_values);
+    swap(lhs.m_size, rhs.m_size);
+    swap(lhs.m_rank, rhs.m_rank);
+  }
+};
+
+#endif
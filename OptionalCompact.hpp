@@ -0,0 +1,412 @@
+/*
+*  MIT License
+*  
+*  Copyright (c) 2025 Pawel Drzycimski
+*  
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*  
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+*  
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*
+*/
+
+#ifndef PDY_OPTIONAL_COMPACT_HPP_
+#define PDY_OPTIONAL_COMPACT_HPP_
+
+#include "Optional.hpp"
+#include "OptionalArray.hpp"
+#include "OptionalBitmap.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+/*
+*  Stream compaction of nullable data:
+*
+*    compact(in, n, out, idxOut)   engaged values of in[0, n) to out, their indices to idxOut,
+*                                  returns how many there were
+*    expand(values, idx, count, out, n)
+*                                  the inverse, out[0, n) becomes empty but out[idx[k]] = values[k]
+*
+*  'in' is either an array of Optional<T> or an OptionalArray<T>. idxOut may be nullptr.
+*  out and idxOut have to have room for n elements, not just for the engaged ones:
+*  the kernels store unconditionally and only advance past the engaged elements.
+*  Indices are 32 bit, so n must fit in uint32_t.
+*
+*  Trivially copyable T goes through a branchless store-and-advance loop. For 4 and 8 byte T
+*  there are AVX2 (4 byte, Optional<T> arrays) and AVX-512 compress paths, picked at compile
+*  time from __AVX2__ / __AVX512F__ / __AVX512VL__, e.g. with -march=native.
+*/
+
+namespace detail {
+
+// value at offset 0, engaged flag right after it, nothing else
+template<typename T>
+struct compact_simd_layout : std::integral_constant<bool,
+    std::is_trivially_copyable<T>::value
+    && (sizeof(T) == 4 || sizeof(T) == 8)
+    && sizeof(Optional<T>) == 2 * sizeof(T)
+    && offsetof(optional_storage<T>, engaged) == sizeof(T)>
+{};
+
+// stores one slot past the last engaged value while it runs, 'capacity' is the room in out,
+// reaching it means every engaged value is stored already
+template<typename T>
+size_t compact_scalar(const Optional<T> *in, size_t begin, size_t n, non_const_t<T> *out, uint32_t *idxOut, size_t k,
+    size_t capacity)
+{
+  if(std::is_trivially_copyable<T>::value)
+  {
+    for(size_t i = begin; i < n && k < capacity; ++i)
+    {
+      const auto &storage = optional_access::storage(in[i]);
+
+      // copies the indeterminate bytes of an empty slot too, the next store overwrites them
+      std::memcpy(static_cast<void*>(out + k), static_cast<const void*>(&storage.value), sizeof(T));
+      if(idxOut)
+        idxOut[k] = static_cast<uint32_t>(i);
+
+      k += storage.engaged;
+    }
+  }
+  else
+  {
+    for(size_t i = begin; i < n; ++i)
+    {
+      if(in[i])
+      {
+        out[k] = *in[i];
+        if(idxOut)
+          idxOut[k] = static_cast<uint32_t>(i);
+        ++k;
+      }
+    }
+  }
+
+  return k;
+}
+
+#if defined(__AVX512F__)
+
+// 16 Optional<4 byte T> are 128 bytes: dwords alternate value, flag
+inline size_t compact_avx512_32(const void *in, size_t n, void *out, uint32_t *idxOut, size_t &i)
+{
+  const auto *src = static_cast<const unsigned char*>(in);
+  auto *dst = static_cast<int*>(out);
+
+  const __m512i evens = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+  const __m512i odds = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+  const __m512i flagByte = _mm512_set1_epi32(0xFF);
+  const __m512i iota = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+  size_t k = 0;
+  for(; i + 16 <= n; i += 16)
+  {
+    const __m512i lo = _mm512_loadu_si512(src + i * 8);
+    const __m512i hi = _mm512_loadu_si512(src + i * 8 + 64);
+
+    const __m512i values = _mm512_permutex2var_epi32(lo, evens, hi);
+    const __m512i flags = _mm512_permutex2var_epi32(lo, odds, hi);
+    const __mmask16 mask = _mm512_test_epi32_mask(flags, flagByte);
+
+    _mm512_mask_compressstoreu_epi32(dst + k, mask, values);
+    if(idxOut)
+    {
+      const __m512i idx = _mm512_add_epi32(iota, _mm512_set1_epi32(static_cast<int>(i)));
+      _mm512_mask_compressstoreu_epi32(idxOut + k, mask, idx);
+    }
+
+    k += popcount64(mask);
+  }
+
+  return k;
+}
+
+// 8 Optional<8 byte T> are 128 bytes: qwords alternate value, flag
+inline size_t compact_avx512_64(const void *in, size_t n, void *out, uint32_t *idxOut, size_t &i)
+{
+  const auto *src = static_cast<const unsigned char*>(in);
+  auto *dst = static_cast<long long*>(out);
+
+  const __m512i evens = _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14);
+  const __m512i odds = _mm512_setr_epi64(1, 3, 5, 7, 9, 11, 13, 15);
+  const __m512i flagByte = _mm512_set1_epi64(0xFF);
+
+  size_t k = 0;
+  for(; i + 8 <= n; i += 8)
+  {
+    const __m512i lo = _mm512_loadu_si512(src + i * 16);
+    const __m512i hi = _mm512_loadu_si512(src + i * 16 + 64);
+
+    const __m512i values = _mm512_permutex2var_epi64(lo, evens, hi);
+    const __m512i flags = _mm512_permutex2var_epi64(lo, odds, hi);
+    const __mmask8 mask = _mm512_test_epi64_mask(flags, flagByte);
+
+    _mm512_mask_compressstoreu_epi64(dst + k, mask, values);
+    if(idxOut)
+    {
+#if defined(__AVX512VL__)
+      const __m256i idx = _mm256_add_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(static_cast<int>(i)));
+      _mm256_mask_compressstoreu_epi32(idxOut + k, mask, idx);
+#else
+      size_t pos = k;
+      for(unsigned bits = mask; bits != 0; bits &= bits - 1)
+        idxOut[pos++] = static_cast<uint32_t>(i + ctz64(bits));
+#endif
+    }
+
+    k += popcount64(mask);
+  }
+
+  return k;
+}
+
+#endif
+
+#if defined(__AVX2__)
+
+// permutation moving the lanes set in the 8 bit mask to the front
+struct compact_avx2_lut
+{
+  uint32_t lanes[256][8];
+
+  compact_avx2_lut() noexcept
+  {
+    for(unsigned mask = 0; mask < 256; ++mask)
+    {
+      unsigned pos = 0;
+      for(unsigned lane = 0; lane < 8; ++lane)
+      {
+        if(mask & (1u << lane))
+          lanes[mask][pos++] = lane;
+      }
+
+      while(pos < 8)
+        lanes[mask][pos++] = 0;
+    }
+  }
+};
+
+inline const compact_avx2_lut& avx2_lut() noexcept
+{
+  static const compact_avx2_lut lut;
+  return lut;
+}
+
+// 8 Optional<4 byte T> are 64 bytes: dwords alternate value, flag
+// stores 8 lanes every step, so only while out has room for them
+inline size_t compact_avx2_32(const void *in, size_t n, void *out, uint32_t *idxOut, size_t &i, size_t capacity)
+{
+  const auto *src = static_cast<const unsigned char*>(in);
+  auto *dst = static_cast<unsigned char*>(out);
+  const compact_avx2_lut &lut = avx2_lut();
+
+  const __m256i split = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+  const __m256i flagByte = _mm256_set1_epi32(0xFF);
+  const __m256i iota = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+  size_t k = 0;
+  for(; i + 8 <= n && k + 8 <= capacity; i += 8)
+  {
+    const __m256i lo = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 8)), split);
+    const __m256i hi = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 8 + 32)), split);
+
+    const __m256i values = _mm256_permute2x128_si256(lo, hi, 0x20);
+    const __m256i flags = _mm256_and_si256(_mm256_permute2x128_si256(lo, hi, 0x31), flagByte);
+    const __m256i empty = _mm256_cmpeq_epi32(flags, _mm256_setzero_si256());
+    const unsigned mask = ~static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(empty))) & 0xFFu;
+
+    const __m256i perm = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lut.lanes[mask]));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k * 4), _mm256_permutevar8x32_epi32(values, perm));
+    if(idxOut)
+    {
+      const __m256i idx = _mm256_add_epi32(iota, _mm256_set1_epi32(static_cast<int>(i)));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(idxOut + k), _mm256_permutevar8x32_epi32(idx, perm));
+    }
+
+    k += popcount64(mask);
+  }
+
+  return k;
+}
+
+#endif
+
+// the AVX-512 paths store through a mask, never more than the engaged values
+template<typename T>
+size_t compact_simd(const Optional<T> *in, size_t n, non_const_t<T> *out, uint32_t *idxOut, size_t &i, size_t capacity)
+{
+  i = 0;
+  if(!compact_simd_layout<T>::value)
+    return 0;
+
+#if defined(__AVX512F__)
+  (void)capacity;
+  if(sizeof(T) == 4)
+    return compact_avx512_32(in, n, out, idxOut, i);
+
+  return compact_avx512_64(in, n, out, idxOut, i);
+#elif defined(__AVX2__)
+  if(sizeof(T) == 4)
+    return compact_avx2_32(in, n, out, idxOut, i, capacity);
+
+  return 0;
+#else
+  (void)in;
+  (void)n;
+  (void)out;
+  (void)idxOut;
+  (void)capacity;
+  return 0;
+#endif
+}
+
+// engaged values of in[0, n) to out, which has room for 'capacity' of them;
+// exactly the engaged count is enough
+template<typename T>
+size_t compact_n(const Optional<T> *in, size_t n, non_const_t<T> *out, uint32_t *idxOut, size_t capacity)
+{
+  size_t i = 0;
+  const size_t k = compact_simd(in, n, out, idxOut, i, capacity);
+  return compact_scalar(in, i, n, out, idxOut, k, capacity);
+}
+
+// words [beginWord, endWord) of an OptionalArray bitmap of 'size' elements, writes only the engaged values
+template<typename T>
+size_t compact_words(const uint64_t *words, const T *values, size_t size, size_t beginWord, size_t endWord,
+    T *out, uint32_t *idxOut)
+{
+  size_t k = 0;
+  size_t w = beginWord;
+
+#if defined(__AVX512F__)
+  if(std::is_trivially_copyable<T>::value && (sizeof(T) == 4 || sizeof(T) == 8))
+  {
+    // bits past size() are never set, so whole words are safe to process
+    // as long as the value slots behind them exist
+    const size_t fullWords = std::min(endWord, size / 64);
+    for(; w < fullWords; ++w)
+    {
+      const uint64_t word = words[w];
+      const auto *src = reinterpret_cast<const unsigned char*>(values + w * 64);
+      const int base = static_cast<int>(w * 64);
+
+      const size_t lanes = 64 / sizeof(T);
+      for(size_t part = 0; part < sizeof(T); ++part)
+      {
+        const __m512i vals = _mm512_loadu_si512(src + part * 64);
+        const uint64_t bits = (word >> (part * lanes)) & ((uint64_t{1} << lanes) - 1);
+
+        if(sizeof(T) == 4)
+        {
+          const auto mask = static_cast<__mmask16>(bits);
+          _mm512_mask_compressstoreu_epi32(out + k, mask, vals);
+          if(idxOut)
+          {
+            const __m512i idx = _mm512_add_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+                _mm512_set1_epi32(base + static_cast<int>(part * lanes)));
+            _mm512_mask_compressstoreu_epi32(idxOut + k, mask, idx);
+          }
+        }
+        else
+        {
+          const auto mask = static_cast<__mmask8>(bits);
+          _mm512_mask_compressstoreu_epi64(out + k, mask, vals);
+          if(idxOut)
+          {
+            size_t pos = k;
+            for(uint64_t rest = bits; rest != 0; rest &= rest - 1)
+              idxOut[pos++] = static_cast<uint32_t>(base + static_cast<int>(part * lanes) + static_cast<int>(ctz64(rest)));
+          }
+        }
+
+        k += popcount64(bits);
+      }
+    }
+  }
+#else
+  (void)size;
+#endif
+
+  for(; w < endWord; ++w)
+  {
+    for(uint64_t bits = words[w]; bits != 0; bits &= bits - 1)
+    {
+      const size_t idx = w * 64 + ctz64(bits);
+      out[k] = values[idx];
+      if(idxOut)
+        idxOut[k] = static_cast<uint32_t>(idx);
+      ++k;
+    }
+  }
+
+  return k;
+}
+
+} // namespace detail
+
+template<typename T>
+size_t compact(const Optional<T> *in, size_t n, T *out, uint32_t *idxOut = nullptr)
+{
+  assert(n <= UINT32_MAX);
+
+  return detail::compact_n(in, n, out, idxOut, n);
+}
+
+template<typename T>
+size_t compact(const OptionalArray<T> &in, T *out, uint32_t *idxOut = nullptr)
+{
+  assert(in.size() <= UINT32_MAX);
+
+  return detail::compact_words(in.bitmap(), in.values(), in.size(), 0, in.bitmap_size(), out, idxOut);
+}
+
+template<typename T>
+void expand(const T *values, const uint32_t *idx, size_t count, Optional<T> *out, size_t n)
+{
+  for(size_t i = 0; i < n; ++i)
+    out[i].reset();
+
+  for(size_t k = 0; k < count; ++k)
+  {
+    assert(idx[k] < n);
+    out[idx[k]] = values[k];
+  }
+}
+
+// 'out' is resized to n
+template<typename T>
+void expand(const T *values, const uint32_t *idx, size_t count, OptionalArray<T> &out, size_t n)
+{
+  out.clear();
+  out.resize(n);
+
+  for(size_t k = 0; k < count; ++k)
+  {
+    assert(idx[k] < n);
+    out.set(idx[k], values[k]);
+  }
+}
+
+#endif
@@ -0,0 +1,178 @@
+/*
+*  MIT License
+*  
+*  Copyright (c) 2025 Pawel Drzycimski
+*  
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*  
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+*  
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*
+*/
+
+#ifndef PDY_OPTIONAL_INDEX_HPP_
+#define PDY_OPTIONAL_INDEX_HPP_
+
+#include "Optional.hpp"
+#include "OptionalBitmap.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+*  OptionalIndex<T> is a read only column for very sparse nullable data. Only the engaged
+*  values are stored, densely, next to a validity bitmap with a rank directory on top:
+*
+*    at(i) = bit i set ? values[rank(i)] : empty
+*
+*  rank(i) is one directory lookup plus at most 8 popcounts, so lookups take constant time.
+*  Memory is count() * sizeof(T) plus about 1.125 bits per element.
+*
+*  OptionalIndexBuilder<T> builder;
+*  for(auto &&opt : stream)
+*    builder.push_back(opt);
+*  const OptionalIndex<T> index = std::move(builder).build();
+*/
+
+template<typename T>
+class OptionalIndexBuilder;
+
+template<typename T>
+class OptionalIndex final
+{
+  friend class OptionalIndexBuilder<T>;
+
+  std::vector<uint64_t> m_words;
+  std::vector<T> m_values;
+  detail::bitmap_rank m_rank;
+  size_t m_size = 0;
+
+public:
+  OptionalIndex() = default;
+
+  size_t size() const noexcept { return m_size; }
+  bool empty() const noexcept { return m_size == 0; }
+  size_t count() const noexcept { return m_values.size(); }
+
+  bool has_value(size_t idx) const noexcept
+  {
+    assert(idx < m_size);
+    return detail::bitmap_test(m_words.data(), idx);
+  }
+
+  Optional<const T&> at(size_t idx) const noexcept
+  {
+    if(!has_value(idx))
+      return Optional<const T&>();
+
+    return Optional<const T&>(m_values[m_rank.rank(m_words.data(), idx)]);
+  }
+
+  Optional<const T&> operator[](size_t idx) const noexcept { return at(idx); }
+
+  // engaged values, in index order
+  const T* values() const noexcept { return m_values.data(); }
+  const uint64_t* bitmap() const noexcept { return m_words.data(); }
+
+  // f(index, value) for every engaged element, in order
+  template<typename F>
+  void for_each_engaged(F &&f) const
+  {
+    size_t pos = 0;
+    detail::bitmap_for_each_set(m_words.data(), m_words.size(), [&](size_t idx) {
+      f(idx, m_values[pos++]);
+    });
+  }
+
+  size_t memory_usage() const noexcept
+  {
+    return m_words.capacity() * sizeof(uint64_t) + m_values.capacity() * sizeof(T) + m_rank.memory_usage();
+  }
+};
+
+// consumes the elements in order, build() hands over the buffers
+template<typename T>
+class OptionalIndexBuilder final
+{
+  OptionalIndex<T> m_index;
+
+  void advance(bool engaged)
+  {
+    const size_t idx = m_index.m_size++;
+    if(idx % 64 == 0)
+      m_index.m_words.push_back(0);
+
+    m_index.m_words.back() |= static_cast<uint64_t>(engaged) << (idx % 64);
+  }
+
+public:
+  size_t size() const noexcept { return m_index.m_size; }
+
+  void push_back(const Optional<T> &opt)
+  {
+    if(opt)
+      m_index.m_values.push_back(*opt);
+
+    advance(opt.has_value());
+  }
+
+  void push_back(Optional<T> &&opt)
+  {
+    if(opt)
+      m_index.m_values.push_back(std::move(*opt));
+
+    advance(opt.has_value());
+  }
+
+  // a run of 'count' empty elements, without touching them one by one
+  void push_empty(size_t count)
+  {
+    m_index.m_size += count;
+    m_index.m_words.resize(detail::bitmap_words(m_index.m_size), 0);
+  }
+
+  template<typename It>
+  void append(It first, It last)
+  {
+    for(; first != last; ++first)
+      push_back(*first);
+  }
+
+  OptionalIndex<T> build() &&
+  {
+    m_index.m_values.shrink_to_fit();
+    m_index.m_words.shrink_to_fit();
+    m_index.m_rank.build(m_index.m_words.data(), m_index.m_words.size());
+
+    OptionalIndex<T> ret(std::move(m_index));
+    m_index = OptionalIndex<T>();
+    return ret;
+  }
+};
+
+template<typename It>
+auto make_optional_index(It first, It last) -> OptionalIndex<typename std::decay<decltype(**first)>::type>
+{
+  OptionalIndexBuilder<typename std::decay<decltype(**first)>::type> builder;
+  builder.append(first, last);
+  return std::move(builder).build();
+}
+
+#endif
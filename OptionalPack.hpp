@@ -0,0 +1,143 @@
+/*
+*  MIT License
+*  
+*  Copyright (c) 2025 Pawel Drzycimski
+*  
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*  
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+*  
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*
+*/
+
+#ifndef PDY_OPTIONAL_PACK_HPP_
+#define PDY_OPTIONAL_PACK_HPP_
+
+#include "Optional.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+/*
+*  Several independent Optionals checked in one go instead of a chain of ifs:
+*
+*    optional_mask(a, b, c)       bit i set when the i-th argument is engaged, here 0b000 - 0b111
+*    optional_any(a, b, c)        at least one engaged
+*    optional_all(a, b, c)        every one engaged
+*    optional_apply(f, a, b, c)   f(*a, *b, *c) only when every one is engaged
+*
+*  The mask is built from the engaged flags with shifts and ors, no branch per argument,
+*  so a handler with many optional inputs can switch once on it:
+*
+*    switch(optional_mask(user, session, token))
+*    {
+*      case 0b111: ...  // all three present
+*      case 0b001: ...  // user only
+*      default: ...
+*    }
+*
+*  optional_apply returns Optional<R> holding f's result, or a bool telling whether f ran
+*  when f returns void. Optionals passed as rvalues hand their payloads to f as rvalues.
+*  The mask queries are constexpr, up to 64 arguments.
+*/
+
+namespace detail {
+
+constexpr size_t PACK_MAX_SIZE = 64;
+
+template<size_t Bit>
+constexpr uint64_t pack_mask() noexcept
+{
+  return 0;
+}
+
+template<size_t Bit, typename O, typename ...Rest>
+constexpr uint64_t pack_mask(const O &opt, const Rest& ...rest) noexcept
+{
+  return (static_cast<uint64_t>(opt.has_value()) << Bit) | pack_mask<Bit + 1>(rest...);
+}
+
+template<size_t N>
+constexpr uint64_t pack_full_mask() noexcept
+{
+  return N == PACK_MAX_SIZE ? ~uint64_t{0} : (uint64_t{1} << (N % PACK_MAX_SIZE)) - 1;
+}
+
+template<typename F, typename ...Opts>
+using pack_result_t = decltype(std::declval<F>()(*std::declval<Opts>()...));
+
+template<typename R>
+struct pack_apply
+{
+  using type = Optional<R>;
+
+  template<typename F, typename ...Opts>
+  static type call(bool all, F &&f, Opts&& ...opts)
+  {
+    if(!all)
+      return type{};
+
+    return type(std::forward<F>(f)(*std::forward<Opts>(opts)...));
+  }
+};
+
+template<>
+struct pack_apply<void>
+{
+  using type = bool;
+
+  template<typename F, typename ...Opts>
+  static type call(bool all, F &&f, Opts&& ...opts)
+  {
+    if(!all)
+      return false;
+
+    std::forward<F>(f)(*std::forward<Opts>(opts)...);
+    return true;
+  }
+};
+
+} // namespace detail
+
+template<typename ...Opts>
+constexpr uint64_t optional_mask(const Opts& ...opts) noexcept
+{
+  static_assert(sizeof...(Opts) <= detail::PACK_MAX_SIZE, "optional_mask: at most 64 Optionals fit the mask");
+  return detail::pack_mask<0>(opts...);
+}
+
+template<typename ...Opts>
+constexpr bool optional_any(const Opts& ...opts) noexcept
+{
+  return optional_mask(opts...) != 0;
+}
+
+template<typename ...Opts>
+constexpr bool optional_all(const Opts& ...opts) noexcept
+{
+  return optional_mask(opts...) == detail::pack_full_mask<sizeof...(Opts)>();
+}
+
+template<typename F, typename ...Opts>
+typename detail::pack_apply<detail::pack_result_t<F, Opts...>>::type optional_apply(F &&f, Opts&& ...opts)
+{
+  return detail::pack_apply<detail::pack_result_t<F, Opts...>>::call(optional_all(opts...),
+      std::forward<F>(f), std::forward<Opts>(opts)...);
+}
+
+#endif
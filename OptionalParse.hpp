@@ -0,0 +1,384 @@
+/*
+*  MIT License
+*  
+*  Copyright (c) 2025 Pawel Drzycimski
+*  
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*  
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+*  
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*
+*/
+
+#ifndef PDY_OPTIONAL_PARSE_HPP_
+#define PDY_OPTIONAL_PARSE_HPP_
+
+#include "Optional.hpp"
+#include "OptionalArray.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+#if defined(__has_include)
+#if __has_include(<charconv>) && __cplusplus >= 201703L
+#include <charconv>
+#endif
+#endif
+
+#if !defined(__cpp_lib_to_chars)
+#include <cerrno>
+#include <cstdlib>
+#endif
+
+/*
+*  parse<T>(b, e) reads the whole of [b, e) as a T, an empty Optional when it is not one:
+*
+*    integers  [+-]?[0-9]+                                 '-' rejected for unsigned T
+*    floats    [+-]?([0-9]+(\.[0-9]*)?|\.[0-9]+)([eE][+-]?[0-9]+)?
+*
+*  No whitespace, no hex, no inf/nan, out of range is empty. There is no locale, no errno
+*  and no allocation on the way.
+*
+*  Digits are validated and converted 8 at a time (SWAR) on little endian hosts. Floats with
+*  up to 2^53 as mantissa and a decimal exponent within +-22 are computed exactly from those
+*  (Clinger's fast path), the rest goes to std::from_chars, or to strtod/strtof from a stack
+*  copy when <charconv> has no floating point support; strtod is locale dependent and gives
+*  up on fields longer than PARSE_FALLBACK_BUFFER.
+*
+*  parse_fields<T>(b, e, ',', column) and parse_range<T>(first, last, column) append to an
+*  OptionalArray<T>, one element per field.
+*/
+
+namespace detail {
+
+constexpr uint64_t SWAR_ZEROS = 0x3030303030303030ull;
+constexpr uint64_t SWAR_HIGH_NIBBLES = 0xF0F0F0F0F0F0F0F0ull;
+constexpr uint64_t SWAR_SIXES = 0x0606060606060606ull;
+constexpr size_t PARSE_FALLBACK_BUFFER = 128;
+
+// non zero byte for every byte of the chunk that is not an ASCII digit,
+// carries out of a non digit byte can only spoil the bytes after it
+inline uint64_t swar_non_digits(uint64_t chunk) noexcept
+{
+  return ((chunk & SWAR_HIGH_NIBBLES) ^ SWAR_ZEROS) | (((chunk + SWAR_SIXES) & SWAR_HIGH_NIBBLES) ^ SWAR_ZEROS);
+}
+
+// 8 digits, the first one in the lowest byte
+inline uint64_t swar_eight_digits(uint64_t chunk) noexcept
+{
+  chunk -= SWAR_ZEROS;
+  chunk = chunk * 10 + (chunk >> 8);
+  return (((chunk & 0x000000FF000000FFull) * (100 + (1000000ull << 32)))
+      + (((chunk >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >> 32;
+}
+
+struct digit_accumulator
+{
+  uint64_t value = 0;
+  bool overflow = false;
+
+  void push(uint64_t digits, uint64_t scale) noexcept
+  {
+    if(overflow)
+      return;
+
+    overflow = __builtin_mul_overflow(value, scale, &value) || __builtin_add_overflow(value, digits, &value);
+  }
+};
+
+// consumes the digits at p, returns where they stop
+inline const char* scan_digits(const char *p, const char *e, digit_accumulator &acc) noexcept
+{
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  while(e - p >= 8)
+  {
+    uint64_t chunk;
+    std::memcpy(&chunk, p, sizeof(chunk));
+
+    if(swar_non_digits(chunk) != 0)
+      break;
+
+    acc.push(swar_eight_digits(chunk), 100000000ull);
+    p += 8;
+  }
+#endif
+
+  for(; p != e && static_cast<unsigned char>(*p - '0') <= 9; ++p)
+    acc.push(static_cast<uint64_t>(*p - '0'), 10);
+
+  return p;
+}
+
+template<typename T>
+Optional<T> parse_integer(const char *b, const char *e) noexcept
+{
+  bool negative = false;
+  if(b != e && (*b == '-' || *b == '+'))
+  {
+    negative = *b == '-';
+    ++b;
+  }
+
+  if(b == e || (negative && !std::is_signed<T>::value))
+    return Optional<T>();
+
+  digit_accumulator acc;
+  if(scan_digits(b, e, acc) != e || acc.overflow)
+    return Optional<T>();
+
+  using U = typename std::make_unsigned<T>::type;
+  const uint64_t limit = negative
+    ? static_cast<uint64_t>(static_cast<U>(std::numeric_limits<T>::max())) + 1
+    : static_cast<uint64_t>(std::numeric_limits<T>::max());
+
+  if(acc.value > limit)
+    return Optional<T>();
+
+  // wraps to the negative value in two's complement
+  return static_cast<T>(negative ? static_cast<U>(0 - acc.value) : static_cast<U>(acc.value));
+}
+
+template<typename T>
+struct float_fast_path;
+
+template<>
+struct float_fast_path<double>
+{
+  static constexpr uint64_t MAX_MANTISSA = uint64_t{1} << 53;
+  static constexpr int MAX_EXPONENT = 22;
+
+  static double pow10(int exp) noexcept
+  {
+    static const double table[] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    return table[exp];
+  }
+};
+
+template<>
+struct float_fast_path<float>
+{
+  static constexpr uint64_t MAX_MANTISSA = uint64_t{1} << 24;
+  static constexpr int MAX_EXPONENT = 10;
+
+  static float pow10(int exp) noexcept
+  {
+    static const float table[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+    return table[exp];
+  }
+};
+
+#if defined(__cpp_lib_to_chars)
+
+template<typename T>
+Optional<T> parse_float_slow(const char *b, const char *e) noexcept
+{
+  if(*b == '+')
+    ++b;
+
+  T ret;
+  const auto res = std::from_chars(b, e, ret, std::chars_format::general);
+  if(res.ec != std::errc() || res.ptr != e)
+    return Optional<T>();
+
+  return ret;
+}
+
+#else
+
+inline double parse_strto(const char *str, char **end, double) noexcept { return std::strtod(str, end); }
+inline float parse_strto(const char *str, char **end, float) noexcept { return std::strtof(str, end); }
+
+template<typename T>
+Optional<T> parse_float_slow(const char *b, const char *e) noexcept
+{
+  const size_t len = static_cast<size_t>(e - b);
+  if(len >= PARSE_FALLBACK_BUFFER)
+    return Optional<T>();
+
+  char buffer[PARSE_FALLBACK_BUFFER];
+  std::memcpy(buffer, b, len);
+  buffer[len] = '\0';
+
+  const int savedErrno = errno;
+  errno = 0;
+  char *end = nullptr;
+  const T ret = parse_strto(buffer, &end, T{});
+  const bool ok = end == buffer + len && errno == 0;
+  errno = savedErrno;
+
+  if(!ok)
+    return Optional<T>();
+
+  return ret;
+}
+
+#endif
+
+template<typename T>
+Optional<T> parse_float(const char *b, const char *e) noexcept
+{
+  using Fast = float_fast_path<T>;
+
+  const char *p = b;
+  bool negative = false;
+  if(p != e && (*p == '-' || *p == '+'))
+  {
+    negative = *p == '-';
+    ++p;
+  }
+
+  digit_accumulator acc;
+  const char *intEnd = scan_digits(p, e, acc);
+  size_t digits = static_cast<size_t>(intEnd - p);
+  p = intEnd;
+
+  long exp10 = 0;
+  if(p != e && *p == '.')
+  {
+    const char *fracBegin = p + 1;
+    p = scan_digits(fracBegin, e, acc);
+    digits += static_cast<size_t>(p - fracBegin);
+    exp10 -= static_cast<long>(p - fracBegin);
+  }
+
+  if(digits == 0)
+    return Optional<T>();
+
+  if(p != e && (*p == 'e' || *p == 'E'))
+  {
+    ++p;
+    bool expNegative = false;
+    if(p != e && (*p == '-' || *p == '+'))
+    {
+      expNegative = *p == '-';
+      ++p;
+    }
+
+    // saturating, anything this far out is decided by the slow path
+    long exp = 0;
+    const char *expBegin = p;
+    for(; p != e && static_cast<unsigned char>(*p - '0') <= 9; ++p)
+    {
+      if(exp < 100000)
+        exp = exp * 10 + (*p - '0');
+    }
+
+    if(p == expBegin)
+      return Optional<T>();
+
+    exp10 += expNegative ? -exp : exp;
+  }
+
+  if(p != e)
+    return Optional<T>();
+
+  if(!acc.overflow && acc.value == 0)
+    return negative ? -T{0} : T{0};
+
+  if(!acc.overflow && acc.value <= Fast::MAX_MANTISSA && exp10 >= -Fast::MAX_EXPONENT && exp10 <= Fast::MAX_EXPONENT)
+  {
+    T ret = static_cast<T>(acc.value);
+    if(exp10 < 0)
+      ret /= Fast::pow10(static_cast<int>(-exp10));
+    else
+      ret *= Fast::pow10(static_cast<int>(exp10));
+
+    return negative ? -ret : ret;
+  }
+
+  return parse_float_slow<T>(b, e);
+}
+
+template<typename T>
+struct is_parsable : std::integral_constant<bool,
+    (std::is_integral<T>::value && !std::is_same<T, bool>::value)
+    || std::is_same<T, double>::value || std::is_same<T, float>::value>
+{};
+
+} // namespace detail
+
+template<typename T>
+typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, Optional<T>>::type
+parse(const char *b, const char *e) noexcept
+{
+  return detail::parse_integer<T>(b, e);
+}
+
+template<typename T>
+typename std::enable_if<std::is_same<T, double>::value || std::is_same<T, float>::value, Optional<T>>::type
+parse(const char *b, const char *e) noexcept
+{
+  return detail::parse_float<T>(b, e);
+}
+
+// one element per field, an empty field is an empty element; returns the number parsed
+template<typename T>
+size_t parse_fields(const char *b, const char *e, char delim, OptionalArray<T> &out)
+{
+  static_assert(detail::is_parsable<T>::value, "parse_fields needs an integer, float or double column");
+
+  size_t parsed = 0;
+  for(;;)
+  {
+    const void *found = std::memchr(b, delim, static_cast<size_t>(e - b));
+    const char *fieldEnd = found ? static_cast<const char*>(found) : e;
+
+    const Optional<T> val = parse<T>(b, fieldEnd);
+    parsed += val.has_value();
+    out.push_back(val);
+
+    if(!found)
+      break;
+
+    b = fieldEnd + 1;
+  }
+
+  return parsed;
+}
+
+// *first has data() and size(), std::string or std::string_view alike
+template<typename T, typename It>
+size_t parse_range(It first, It last, OptionalArray<T> &out)
+{
+  static_assert(detail::is_parsable<T>::value, "parse_range needs an integer, float or double column");
+
+  size_t idx = out.size();
+  out.resize(idx + static_cast<size_t>(std::distance(first, last)));
+
+  size_t parsed = 0;
+  for(; first != last; ++first, ++idx)
+  {
+    const char *data = first->data();
+    const Optional<T> val = parse<T>(data, data + first->size());
+    if(val)
+    {
+      out.set(idx, *val);
+      ++parsed;
+    }
+  }
+
+  return parsed;
+}
+
+#endif
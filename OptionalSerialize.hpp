@@ -0,0 +1,498 @@
+/*
+*  MIT License
+*  
+*  Copyright (c) 2025 Pawel Drzycimski
+*  
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*  
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+*  
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*
+*/
+
+#ifndef PDY_OPTIONAL_SERIALIZE_HPP_
+#define PDY_OPTIONAL_SERIALIZE_HPP_
+
+#include "Optional.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+/*
+*  Binary format for arrays of Optional<T>, T has to be trivially copyable.
+*
+*  A stream is a sequence of blocks. Every block starts at an offset (counted from the
+*  beginning of the stream) aligned to A = max(8, alignof(T)), the gap before it is zero filled.
+*
+*  Block:
+*    offset 0    u32   magic, bytes "POPT"
+*    offset 4    u16   format version, currently 1
+*    offset 6    u16   sizeof(T)
+*    offset 8    u64   element count N
+*    offset 16   u64   validity bitmap, ceil(N / 64) words, element i is engaged when
+*                      bit (i % 64) of word (i / 64) is set, unused high bits of the last word are 0
+*    offset V    T     engaged values only, densely packed in element order,
+*                      V = 16 + 8 * ceil(N / 64) rounded up to A, gap zero filled
+*
+*  All integers are little-endian. Arithmetic payloads are stored little-endian as well,
+*  any other T is stored as its object representation and is only portable between hosts
+*  sharing the same ABI.
+*
+*  Sink is anything with   void write(const void *data, size_t size)
+*  Source is anything with size_t read(void *data, size_t size)   returning the number of bytes read,
+*  and optionally uint64_t remaining() const, which lets the reader reject a block whose header
+*  promises more data than is left before allocating for it.
+*/
+
+namespace detail {
+
+constexpr uint32_t SERIAL_MAGIC = 0x54504F50u; // "POPT" once stored little-endian
+constexpr uint16_t SERIAL_VERSION = 1;
+constexpr size_t SERIAL_HEADER_SIZE = 16;
+constexpr size_t SERIAL_STAGING_SIZE = 4096;
+
+template<typename T>
+constexpr size_t serial_alignment() noexcept
+{
+  return alignof(T) > 8 ? alignof(T) : 8;
+}
+
+constexpr uint64_t serial_align_up(uint64_t val, uint64_t alignment) noexcept
+{
+  return (val + alignment - 1) / alignment * alignment;
+}
+
+constexpr uint64_t serial_bitmap_words(uint64_t count) noexcept
+{
+  return (count + 63) / 64;
+}
+
+// offset of the values relative to the block start
+template<typename T>
+constexpr uint64_t serial_values_offset(uint64_t count) noexcept
+{
+  return serial_align_up(SERIAL_HEADER_SIZE + 8 * serial_bitmap_words(count), serial_alignment<T>());
+}
+
+// compilers fold this into a single store/load on little-endian hosts
+inline void put_le(unsigned char *dst, uint64_t val, size_t bytes) noexcept
+{
+  for(size_t i = 0; i < bytes; ++i)
+    dst[i] = static_cast<unsigned char>(val >> (8 * i));
+}
+
+inline uint64_t get_le(const unsigned char *src, size_t bytes) noexcept
+{
+  uint64_t ret = 0;
+  for(size_t i = 0; i < bytes; ++i)
+    ret |= static_cast<uint64_t>(src[i]) << (8 * i);
+
+  return ret;
+}
+
+template<typename T>
+inline void serial_fix_byte_order(unsigned char *val) noexcept
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  if(std::is_arithmetic<T>::value)
+    std::reverse(val, val + sizeof(T));
+#else
+  (void)val;
+#endif
+}
+
+struct serial_header
+{
+  uint64_t count;
+  uint16_t valueSize;
+};
+
+inline void serial_encode_header(unsigned char *dst, uint16_t valueSize, uint64_t count) noexcept
+{
+  put_le(dst, SERIAL_MAGIC, 4);
+  put_le(dst + 4, SERIAL_VERSION, 2);
+  put_le(dst + 6, valueSize, 2);
+  put_le(dst + 8, count, 8);
+}
+
+inline bool serial_decode_header(const unsigned char *src, serial_header &header) noexcept
+{
+  if(get_le(src, 4) != SERIAL_MAGIC || get_le(src + 4, 2) != SERIAL_VERSION)
+    return false;
+
+  header.valueSize = static_cast<uint16_t>(get_le(src + 6, 2));
+  header.count = get_le(src + 8, 8);
+  return true;
+}
+
+// the last word must not have bits set past the element count
+inline bool serial_valid_tail(uint64_t lastWord, uint64_t count) noexcept
+{
+  const unsigned used = static_cast<unsigned>(count % 64);
+  return used == 0 || (lastWord >> used) == 0;
+}
+
+// bytes left in the source, or 'unknown' for sources that can't tell
+template<typename Source>
+auto serial_remaining(const Source &source, int) noexcept -> decltype(static_cast<uint64_t>(source.remaining()))
+{
+  return static_cast<uint64_t>(source.remaining());
+}
+
+template<typename Source>
+uint64_t serial_remaining(const Source&, long) noexcept
+{
+  return UINT64_MAX;
+}
+
+} // namespace detail
+
+template<typename Sink>
+class OptionalWriter
+{
+  Sink &m_sink;
+  uint64_t m_offset;
+
+  void put(const void *data, size_t size)
+  {
+    m_sink.write(data, size);
+    m_offset += size;
+  }
+
+  void pad_to(uint64_t alignment)
+  {
+    static const unsigned char zeros[64] = {};
+
+    uint64_t gap = detail::serial_align_up(m_offset, alignment) - m_offset;
+    while(gap > 0)
+    {
+      const size_t chunk = static_cast<size_t>(std::min<uint64_t>(gap, sizeof(zeros)));
+      put(zeros, chunk);
+      gap -= chunk;
+    }
+  }
+
+public:
+  explicit OptionalWriter(Sink &sink) noexcept
+    : m_sink(sink), m_offset{0}
+  {}
+
+  uint64_t offset() const noexcept { return m_offset; }
+
+  template<typename T>
+  void write(const Optional<T> *first, size_t count)
+  {
+    using Value = detail::non_const_t<T>;
+    using access = detail::optional_access;
+
+    static_assert(std::is_trivially_copyable<Value>::value, "serialization requires trivially copyable T");
+    static_assert(sizeof(Value) <= 0xFFFF, "value too big for the block header");
+
+    pad_to(detail::serial_alignment<Value>());
+
+    unsigned char buf[detail::SERIAL_STAGING_SIZE];
+    detail::serial_encode_header(buf, static_cast<uint16_t>(sizeof(Value)), count);
+    put(buf, detail::SERIAL_HEADER_SIZE);
+
+    size_t used = 0;
+    for(size_t base = 0; base < count; base += 64)
+    {
+      const size_t end = std::min(count, base + 64);
+
+      uint64_t word = 0;
+      for(size_t i = base; i < end; ++i)
+        word |= static_cast<uint64_t>(access::storage(first[i]).engaged) << (i - base);
+
+      detail::put_le(buf + used, word, 8);
+      used += 8;
+      if(used == sizeof(buf))
+      {
+        put(buf, used);
+        used = 0;
+      }
+    }
+
+    if(used > 0)
+      put(buf, used);
+
+    pad_to(detail::serial_alignment<Value>());
+
+    const size_t perChunk = sizeof(buf) / sizeof(Value);
+    if(perChunk == 0)
+    {
+      for(size_t i = 0; i < count; ++i)
+      {
+        if(first[i].has_value())
+          put(static_cast<const void*>(&access::storage(first[i]).value), sizeof(Value));
+      }
+      return;
+    }
+
+    // store-and-advance: every slot is copied, the cursor moves only past the engaged ones,
+    // for an empty one this copies the indeterminate bytes of the union which are then overwritten
+    size_t packed = 0;
+    for(size_t i = 0; i < count; ++i)
+    {
+      const auto &storage = access::storage(first[i]);
+      unsigned char *dst = buf + packed * sizeof(Value);
+
+      std::memcpy(dst, static_cast<const void*>(&storage.value), sizeof(Value));
+      detail::serial_fix_byte_order<Value>(dst);
+      packed += storage.engaged;
+
+      if(packed == perChunk)
+      {
+        put(buf, packed * sizeof(Value));
+        packed = 0;
+      }
+    }
+
+    if(packed > 0)
+      put(buf, packed * sizeof(Value));
+  }
+
+  template<typename T>
+  void write(const std::vector<Optional<T>> &opts)
+  {
+    write(opts.data(), opts.size());
+  }
+
+  template<typename T>
+  void write(const Optional<T> &opt)
+  {
+    write(&opt, 1);
+  }
+};
+
+template<typename Source>
+class OptionalReader
+{
+  Source &m_source;
+  uint64_t m_offset;
+
+  bool get(void *data, size_t size)
+  {
+    const size_t got = m_source.read(data, size);
+    m_offset += got;
+    return got == size;
+  }
+
+  bool skip_to(uint64_t alignment)
+  {
+    unsigned char scratch[64];
+
+    uint64_t gap = detail::serial_align_up(m_offset, alignment) - m_offset;
+    while(gap > 0)
+    {
+      const size_t chunk = static_cast<size_t>(std::min<uint64_t>(gap, sizeof(scratch)));
+      if(!get(scratch, chunk))
+        return false;
+
+      gap -= chunk;
+    }
+
+    return true;
+  }
+
+public:
+  explicit OptionalReader(Source &source) noexcept
+    : m_source(source), m_offset{0}
+  {}
+
+  uint64_t offset() const noexcept { return m_offset; }
+
+  // appends the next block to 'out', false on the end of stream or malformed block
+  template<typename T>
+  bool read(std::vector<Optional<T>> &out)
+  {
+    using Value = detail::non_const_t<T>;
+
+    static_assert(std::is_trivially_copyable<Value>::value, "serialization requires trivially copyable T");
+    static_assert(std::is_default_constructible<Value>::value, "deserialization requires default constructible T");
+
+    unsigned char buf[detail::SERIAL_STAGING_SIZE];
+    detail::serial_header header;
+
+    if(!skip_to(detail::serial_alignment<Value>())
+        || !get(buf, detail::SERIAL_HEADER_SIZE)
+        || !detail::serial_decode_header(buf, header)
+        || header.valueSize != sizeof(Value)
+        || header.count > out.max_size() - out.size())
+      return false;
+
+    // the count is untrusted until the bitmap it implies has actually been read,
+    // so the words are taken in staging sized chunks instead of allocated up front
+    const uint64_t wordCount = detail::serial_bitmap_words(header.count);
+    if(wordCount > detail::serial_remaining(m_source, 0) / 8)
+      return false;
+
+    std::vector<uint64_t> words;
+    uint64_t engaged = 0;
+    while(words.size() < wordCount)
+    {
+      const size_t chunk = static_cast<size_t>(std::min<uint64_t>(wordCount - words.size(), sizeof(buf) / 8));
+      if(!get(buf, chunk * 8))
+        return false;
+
+      for(size_t i = 0; i < chunk; ++i)
+      {
+        const uint64_t word = detail::get_le(buf + i * 8, 8);
+        engaged += static_cast<uint64_t>(__builtin_popcountll(word));
+        words.push_back(word);
+      }
+    }
+
+    if(!words.empty() && !detail::serial_valid_tail(words.back(), header.count))
+      return false;
+
+    if(!skip_to(detail::serial_alignment<Value>())
+        || engaged > detail::serial_remaining(m_source, 0) / sizeof(Value))
+      return false;
+
+    const size_t base = out.size();
+    out.resize(base + static_cast<size_t>(header.count));
+
+    // values bigger than the staging buffer are read one by one straight into place
+    const bool staged = sizeof(Value) <= sizeof(buf);
+    size_t wordIdx = 0;
+    uint64_t bits = words.empty() ? 0 : words[0];
+
+    while(engaged > 0)
+    {
+      const size_t chunk = staged ? static_cast<size_t>(std::min<uint64_t>(engaged, sizeof(buf) / sizeof(Value))) : 1;
+      if(staged && !get(buf, chunk * sizeof(Value)))
+      {
+        out.resize(base);
+        return false;
+      }
+
+      for(size_t i = 0; i < chunk; ++i)
+      {
+        Value val;
+        if(staged)
+          std::memcpy(static_cast<void*>(&val), buf + i * sizeof(Value), sizeof(Value));
+        else if(!get(static_cast<void*>(&val), sizeof(Value)))
+        {
+          out.resize(base);
+          return false;
+        }
+
+        detail::serial_fix_byte_order<Value>(reinterpret_cast<unsigned char*>(&val));
+
+        while(bits == 0)
+          bits = words[++wordIdx];
+
+        const size_t idx = wordIdx * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+        bits &= bits - 1;
+
+        out[base + idx] = val;
+      }
+
+      engaged -= chunk;
+    }
+
+    return true;
+  }
+
+  // reads a block of exactly one element
+  template<typename T>
+  bool read(Optional<T> &out)
+  {
+    std::vector<Optional<T>> tmp;
+    if(!read(tmp) || tmp.size() != 1)
+      return false;
+
+    out = std::move(tmp[0]);
+    return true;
+  }
+};
+
+class OptionalBufferSink
+{
+  std::vector<unsigned char> &m_buffer;
+
+public:
+  explicit OptionalBufferSink(std::vector<unsigned char> &buffer) noexcept
+    : m_buffer(buffer)
+  {}
+
+  void write(const void *data, size_t size)
+  {
+    const auto *bytes = static_cast<const unsigned char*>(data);
+    m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+  }
+};
+
+class OptionalBufferSource
+{
+  const unsigned char *m_data;
+  size_t m_size;
+  size_t m_pos;
+
+public:
+  OptionalBufferSource(const void *data, size_t size) noexcept
+    : m_data{static_cast<const unsigned char*>(data)}, m_size{size}, m_pos{0}
+  {}
+
+  size_t read(void *data, size_t size) noexcept
+  {
+    const size_t chunk = std::min(size, m_size - m_pos);
+    if(chunk > 0)
+      std::memcpy(data, m_data + m_pos, chunk);
+
+    m_pos += chunk;
+    return chunk;
+  }
+
+  uint64_t remaining() const noexcept { return m_size - m_pos; }
+};
+
+class OptionalFileSink
+{
+  std::FILE *m_file;
+
+public:
+  explicit OptionalFileSink(std::FILE *file) noexcept
+    : m_file{file}
+  {}
+
+  void write(const void *data, size_t size)
+  {
+    std::fwrite(data, 1, size, m_file);
+  }
+};
+
+class OptionalFileSource
+{
+  std::FILE *m_file;
+
+public:
+  explicit OptionalFileSource(std::FILE *file) noexcept
+    : m_file{file}
+  {}
+
+  size_t read(void *data, size_t size)
+  {
+    return std::fread(data, 1, size, m_file);
+  }
+};
+
+#endif
@@ -0,0 +1,205 @@
+/*
+*  MIT License
+*  
+*  Copyright (c) 2025 Pawel Drzycimski
+*  
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*  
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+*  
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*
+*/
+
+#ifndef PDY_OPTIONAL_SLOT_HPP_
+#define PDY_OPTIONAL_SLOT_HPP_
+
+#include "Optional.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/*
+*  OptionalSlot<T, Align> is an Optional<T> alone on its own Align sized, Align aligned block,
+*  value and engaged flag together, so that slots written by different threads never share
+*  a cache line.
+*
+*  OptionalSlotArray<T, Align> is a fixed number of such slots, one per worker:
+*
+*  OptionalSlotArray<Stats> perWorker(workerCount);
+*  // worker 'w'
+*  perWorker[w] = Stats{};
+*  perWorker[w]->requests++;
+*  // after join
+*  perWorker.for_each_engaged([&](size_t w, Stats &s) { total += s; });
+*
+*  The default Align is 64 rather than std::hardware_destructive_interference_size, which is
+*  C++17 only and which compilers warn about, as its value may change with -mtune.
+*/
+
+namespace detail {
+
+constexpr size_t SLOT_DEFAULT_ALIGN = 64;
+
+} // namespace detail
+
+template<typename T, size_t Align = detail::SLOT_DEFAULT_ALIGN>
+class alignas(Align) OptionalSlot final
+{
+  static_assert((Align & (Align - 1)) == 0, "Align has to be a power of two");
+  static_assert(Align >= alignof(Optional<T>), "Align has to be at least the alignment of Optional<T>");
+
+  Optional<T> m_opt;
+
+public:
+  OptionalSlot() = default;
+
+  OptionalSlot(const Optional<T> &opt)
+    : m_opt(opt)
+  {}
+
+  OptionalSlot(Optional<T> &&opt)
+    : m_opt(std::move(opt))
+  {}
+
+  template<typename U,
+    typename = typename std::enable_if<!std::is_same<typename std::decay<U>::type, OptionalSlot<T, Align>>::value>::type>
+  OptionalSlot<T, Align>& operator=(U &&val)
+  {
+    m_opt = std::forward<U>(val);
+    return *this;
+  }
+
+  Optional<T>& get() noexcept { return m_opt; }
+  const Optional<T>& get() const noexcept { return m_opt; }
+
+  // dereferences to the value, as Optional does
+  T& operator*() { return *m_opt; }
+  const T& operator*() const { return *m_opt; }
+
+  T* operator->() { assert(m_opt.has_value()); return std::addressof(*m_opt); }
+  const T* operator->() const { assert(m_opt.has_value()); return std::addressof(*m_opt); }
+
+  constexpr explicit operator bool() const noexcept { return m_opt.has_value(); }
+  constexpr bool has_value() const noexcept { return m_opt.has_value(); }
+
+  void reset() noexcept(detail::is_noexcept_destructible<T>::value) { m_opt.reset(); }
+};
+
+// operator new only honours alignof up to __STDCPP_DEFAULT_NEW_ALIGNMENT__ before C++17,
+// so the slots live in an over allocated block aligned by hand
+template<typename T, size_t Align = detail::SLOT_DEFAULT_ALIGN>
+class OptionalSlotArray final
+{
+  using Slot = OptionalSlot<T, Align>;
+
+  void *m_block = nullptr;
+  Slot *m_slots = nullptr;
+  size_t m_size = 0;
+
+  void release() noexcept
+  {
+    for(size_t i = 0; i < m_size; ++i)
+      m_slots[i].~Slot();
+
+    ::operator delete(m_block);
+    m_block = nullptr;
+    m_slots = nullptr;
+    m_size = 0;
+  }
+
+public:
+  OptionalSlotArray() = default;
+
+  explicit OptionalSlotArray(size_t workers)
+  {
+    if(workers == 0)
+      return;
+
+    m_block = ::operator new(workers * sizeof(Slot) + Align);
+    const auto addr = reinterpret_cast<uintptr_t>(m_block);
+    m_slots = reinterpret_cast<Slot*>((addr + Align - 1) & ~static_cast<uintptr_t>(Align - 1));
+
+    for(; m_size < workers; ++m_size)
+      ::new(static_cast<void*>(m_slots + m_size)) Slot();
+  }
+
+  OptionalSlotArray(const OptionalSlotArray<T, Align>&) = delete;
+  OptionalSlotArray<T, Align>& operator=(const OptionalSlotArray<T, Align>&) = delete;
+
+  OptionalSlotArray(OptionalSlotArray<T, Align> &&other) noexcept
+    : m_block{other.m_block}, m_slots{other.m_slots}, m_size{other.m_size}
+  {
+    other.m_block = nullptr;
+    other.m_slots = nullptr;
+    other.m_size = 0;
+  }
+
+  OptionalSlotArray<T, Align>& operator=(OptionalSlotArray<T, Align> &&other) noexcept
+  {
+    if(this != &other)
+    {
+      release();
+      std::swap(m_block, other.m_block);
+      std::swap(m_slots, other.m_slots);
+      std::swap(m_size, other.m_size);
+    }
+
+    return *this;
+  }
+
+  ~OptionalSlotArray()
+  {
+    release();
+  }
+
+  size_t size() const noexcept { return m_size; }
+
+  Slot& operator[](size_t worker) noexcept { assert(worker < m_size); return m_slots[worker]; }
+  const Slot& operator[](size_t worker) const noexcept { assert(worker < m_size); return m_slots[worker]; }
+
+  // not synchronized, meant for after the workers are done
+  template<typename F>
+  void for_each_engaged(F &&f)
+  {
+    for(size_t i = 0; i < m_size; ++i)
+    {
+      if(m_slots[i])
+        f(i, *m_slots[i]);
+    }
+  }
+
+  template<typename F>
+  void for_each_engaged(F &&f) const
+  {
+    for(size_t i = 0; i < m_size; ++i)
+    {
+      if(m_slots[i])
+        f(i, *m_slots[i]);
+    }
+  }
+
+  void reset_all() noexcept(detail::is_noexcept_destructible<T>::value)
+  {
+    for(size_t i = 0; i < m_size; ++i)
+      m_slots[i].reset();
+  }
+};
+
+#endif
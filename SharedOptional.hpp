@@ -0,0 +1,225 @@
+/*
+*  MIT License
+*  
+*  Copyright (c) 2025 Pawel Drzycimski
+*  
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*  
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+*  
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*
+*/
+
+#ifndef PDY_SHARED_OPTIONAL_HPP_
+#define PDY_SHARED_OPTIONAL_HPP_
+
+#include "Optional.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+/*
+*  SharedOptional<T> is an Optional<T> read by many threads and replaced now and then,
+*  read-copy-update style: a writer publishes a new payload (or none), readers keep
+*  whichever one they started with for as long as they hold their ReadGuard.
+*
+*  The payload lives on the heap behind an atomic pointer. Readers announce themselves in a
+*  counter picked by thread out of ReaderSlots cache line sized slots, two counters per slot
+*  for the two parities of the current epoch. Entering is an epoch load and one increment,
+*  leaving one decrement, both on a line other threads don't touch as long as there are no
+*  more readers than slots; nothing in there ever waits or retries.
+*
+*  A writer swaps the pointer under a mutex and waits out a grace period before deleting
+*  the old payload: it flips the epoch and waits for the counters of the old parity to
+*  drain, twice, so that a reader which loaded the epoch right before a flip is covered too.
+*  Writes are therefore slow, reads of a writer's own thread must not overlap them:
+*  storing while holding a ReadGuard on the same thread never returns.
+*
+*  SharedOptional<Config> config{load_config()};
+*  ...
+*  auto guard = config.read();
+*  if(guard)
+*    use(guard->timeout);
+*  ...
+*  config.store(load_config());
+*/
+
+namespace detail {
+
+constexpr size_t SHARED_READER_SLOTS = 64;
+constexpr size_t SHARED_SLOT_ALIGN = 64;
+
+struct alignas(SHARED_SLOT_ALIGN) shared_reader_slot
+{
+  std::atomic<uint64_t> readers[2];
+
+  shared_reader_slot() noexcept
+  {
+    readers[0].store(0, std::memory_order_relaxed);
+    readers[1].store(0, std::memory_order_relaxed);
+  }
+};
+
+// threads get consecutive indices, the first ReaderSlots readers never share a slot
+inline size_t shared_reader_index() noexcept
+{
+  static std::atomic<size_t> next{0};
+  static thread_local const size_t index = next.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+} // namespace detail
+
+template<typename T, size_t ReaderSlots = detail::SHARED_READER_SLOTS>
+class SharedOptional final
+{
+  static_assert(ReaderSlots > 0, "SharedOptional needs at least one reader slot");
+
+  using Slot = detail::shared_reader_slot;
+
+  std::atomic<T*> m_ptr;
+  std::atomic<uint64_t> m_epoch;
+  std::mutex m_writeMutex;
+  mutable Slot m_slots[ReaderSlots];
+
+  void synchronize() noexcept
+  {
+    for(int round = 0; round < 2; ++round)
+    {
+      const uint64_t parity = m_epoch.fetch_add(1, std::memory_order_seq_cst) & 1u;
+      for(auto &slot : m_slots)
+      {
+        while(slot.readers[parity].load(std::memory_order_seq_cst) != 0)
+          std::this_thread::yield();
+      }
+    }
+  }
+
+  void publish(T *fresh)
+  {
+    T *old = nullptr;
+    {
+      std::lock_guard<std::mutex> lock{m_writeMutex};
+      old = m_ptr.exchange(fresh, std::memory_order_seq_cst);
+      if(old)
+        synchronize();
+    }
+
+    delete old;
+  }
+
+public:
+  // snapshot of the payload at the time of read(), kept alive until the guard goes away
+  class ReadGuard final
+  {
+    friend class SharedOptional;
+
+    std::atomic<uint64_t> *m_readers;
+    const T *m_ptr;
+
+    explicit ReadGuard(const SharedOptional &owner) noexcept
+      : m_readers{nullptr}, m_ptr{nullptr}
+    {
+      Slot &slot = owner.m_slots[detail::shared_reader_index() % ReaderSlots];
+      const uint64_t parity = owner.m_epoch.load(std::memory_order_seq_cst) & 1u;
+      m_readers = &slot.readers[parity];
+      m_readers->fetch_add(1, std::memory_order_seq_cst);
+      m_ptr = owner.m_ptr.load(std::memory_order_seq_cst);
+    }
+
+  public:
+    ReadGuard(const ReadGuard&) = delete;
+    ReadGuard& operator=(const ReadGuard&) = delete;
+    ReadGuard& operator=(ReadGuard&&) = delete;
+
+    ReadGuard(ReadGuard &&other) noexcept
+      : m_readers{other.m_readers}, m_ptr{other.m_ptr}
+    {
+      other.m_readers = nullptr;
+      other.m_ptr = nullptr;
+    }
+
+    ~ReadGuard()
+    {
+      if(m_readers)
+        m_readers->fetch_sub(1, std::memory_order_release);
+    }
+
+    Optional<const T&> get() const noexcept
+    {
+      if(!m_ptr)
+        return {};
+
+      return *m_ptr;
+    }
+
+    const T& operator*() const { assert(has_value()); return *m_ptr; }
+    const T* operator->() const { assert(has_value()); return m_ptr; }
+
+    explicit operator bool() const noexcept { return m_ptr != nullptr; }
+    bool has_value() const noexcept { return m_ptr != nullptr; }
+  };
+
+  SharedOptional() noexcept
+    : m_ptr{nullptr}, m_epoch{0}, m_writeMutex{}, m_slots{}
+  {}
+
+  explicit SharedOptional(const T &val)
+    : m_ptr{new T(val)}, m_epoch{0}, m_writeMutex{}, m_slots{}
+  {}
+
+  explicit SharedOptional(T &&val)
+    : m_ptr{new T(std::move(val))}, m_epoch{0}, m_writeMutex{}, m_slots{}
+  {}
+
+  SharedOptional(const SharedOptional&) = delete;
+  SharedOptional& operator=(const SharedOptional&) = delete;
+
+  // no reader and no writer may be left at this point
+  ~SharedOptional()
+  {
+    delete m_ptr.load(std::memory_order_acquire);
+  }
+
+  ReadGuard read() const noexcept { return ReadGuard{*this}; }
+
+  // a copy of the current payload, no guard needed afterwards
+  Optional<T> load() const
+  {
+    const ReadGuard guard = read();
+    if(!guard)
+      return {};
+
+    return *guard;
+  }
+
+  bool has_value() const noexcept { return m_ptr.load(std::memory_order_acquire) != nullptr; }
+
+  template<typename ...Args>
+  void emplace(Args&& ...args) { publish(new T(std::forward<Args>(args)...)); }
+
+  void store(const T &val) { publish(new T(val)); }
+  void store(T &&val) { publish(new T(std::move(val))); }
+
+  void reset() { publish(nullptr); }
+};
+
+#endif
@@ -0,0 +1,280 @@
+/*
+*  MIT License
+*  
+*  Copyright (c) 2025 Pawel Drzycimski
+*  
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*  
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+*  
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*
+*/
+
+#ifndef PDY_SLOT_POOL_HPP_
+#define PDY_SLOT_POOL_HPP_
+
+#include "Optional.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+/*
+*  SlotPool<T> hands out SlotHandles to the objects it keeps, get() answers with the object
+*  or with nothing when it has been erased since, even if the slot holds another object now.
+*
+*  Every slot carries a generation next to the payload, odd while the slot is engaged:
+*  insert and erase bump it, a handle remembers the odd value it got. get() is then one
+*  index computation and one compare, and a default constructed handle never matches.
+*  A slot about to wrap its generation is retired instead of reused.
+*
+*  Erased slots go on a free list threaded through the payload storage. Slots live in chunks
+*  of ChunkSize that never move, so references stay valid while the pool grows.
+*
+*  SlotPool<Connection> conns;
+*  const SlotHandle h = conns.insert(socket);
+*  if(auto conn = conns.get(h))
+*    conn->send(data);
+*  conns.erase(h);
+*/
+
+struct SlotHandle
+{
+  uint32_t index = 0;
+  uint32_t generation = 0;
+
+  constexpr SlotHandle() noexcept = default;
+
+  constexpr SlotHandle(uint32_t idx, uint32_t gen) noexcept
+    : index{idx}, generation{gen}
+  {}
+
+  friend bool operator==(const SlotHandle &lhs, const SlotHandle &rhs) noexcept
+  {
+    return lhs.index == rhs.index && lhs.generation == rhs.generation;
+  }
+
+  friend bool operator!=(const SlotHandle &lhs, const SlotHandle &rhs) noexcept
+  {
+    return !(lhs == rhs);
+  }
+};
+
+namespace detail {
+
+constexpr uint32_t SLOT_POOL_NO_FREE = UINT32_MAX;
+
+template<typename T>
+struct pool_slot
+{
+  union {
+    uint32_t nextFree;
+    T value;
+  };
+
+  uint32_t generation;
+
+  pool_slot() noexcept
+    : nextFree{SLOT_POOL_NO_FREE}, generation{0}
+  {}
+
+  // the pool destroys engaged values itself
+  ~pool_slot() {}
+
+  bool engaged() const noexcept { return (generation & 1u) != 0; }
+};
+
+} // namespace detail
+
+template<typename T, size_t ChunkSize = 1024>
+class SlotPool final
+{
+  static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0, "ChunkSize has to be a power of two");
+
+  using Slot = detail::pool_slot<T>;
+
+  std::vector<std::unique_ptr<Slot[]>> m_chunks;
+  uint32_t m_freeHead = detail::SLOT_POOL_NO_FREE;
+  uint32_t m_used = 0;
+  size_t m_size = 0;
+
+  Slot& slot(uint32_t index) noexcept { return m_chunks[index / ChunkSize][index % ChunkSize]; }
+  const Slot& slot(uint32_t index) const noexcept { return m_chunks[index / ChunkSize][index % ChunkSize]; }
+
+  uint32_t acquire()
+  {
+    if(m_freeHead != detail::SLOT_POOL_NO_FREE)
+    {
+      const uint32_t index = m_freeHead;
+      m_freeHead = slot(index).nextFree;
+      return index;
+    }
+
+    assert(m_used < detail::SLOT_POOL_NO_FREE);
+    if(m_used == m_chunks.size() * ChunkSize)
+    {
+      std::unique_ptr<Slot[]> chunk(new Slot[ChunkSize]);
+      m_chunks.push_back(std::move(chunk));
+    }
+
+    return m_used++;
+  }
+
+  void release(uint32_t index) noexcept(detail::is_noexcept_destructible<T>::value)
+  {
+    Slot &s = slot(index);
+    s.value.T::~T();
+    ++s.generation;
+    --m_size;
+
+    // a wrapped generation would make old handles valid again
+    if(s.generation == UINT32_MAX - 1)
+      return;
+
+    s.nextFree = m_freeHead;
+    m_freeHead = index;
+  }
+
+public:
+  using Handle = SlotHandle;
+
+  SlotPool() = default;
+
+  SlotPool(const SlotPool<T, ChunkSize>&) = delete;
+  SlotPool<T, ChunkSize>& operator=(const SlotPool<T, ChunkSize>&) = delete;
+
+  SlotPool(SlotPool<T, ChunkSize> &&other) noexcept
+    : m_chunks{std::move(other.m_chunks)}, m_freeHead{other.m_freeHead}, m_used{other.m_used}, m_size{other.m_size}
+  {
+    other.m_chunks.clear();
+    other.m_freeHead = detail::SLOT_POOL_NO_FREE;
+    other.m_used = 0;
+    other.m_size = 0;
+  }
+
+  SlotPool<T, ChunkSize>& operator=(SlotPool<T, ChunkSize> &&other) noexcept
+  {
+    if(this != &other)
+    {
+      clear();
+      m_chunks = std::move(other.m_chunks);
+      m_freeHead = other.m_freeHead;
+      m_used = other.m_used;
+      m_size = other.m_size;
+
+      other.m_chunks.clear();
+      other.m_freeHead = detail::SLOT_POOL_NO_FREE;
+      other.m_used = 0;
+      other.m_size = 0;
+    }
+
+    return *this;
+  }
+
+  ~SlotPool()
+  {
+    clear();
+  }
+
+  size_t size() const noexcept { return m_size; }
+  bool empty() const noexcept { return m_size == 0; }
+  size_t capacity() const noexcept { return m_chunks.size() * ChunkSize; }
+
+  template<typename ...Args>
+  Handle insert(Args&& ...args)
+  {
+    const uint32_t index = acquire();
+    Slot &s = slot(index);
+
+    // back on the free list if the constructor throws, the generation stays even
+    struct Guard
+    {
+      SlotPool<T, ChunkSize> *pool;
+      uint32_t index;
+      ~Guard()
+      {
+        if(pool)
+        {
+          pool->slot(index).nextFree = pool->m_freeHead;
+          pool->m_freeHead = index;
+        }
+      }
+    } guard{this, index};
+
+    ::new(static_cast<void*>(std::addressof(s.value))) T(std::forward<Args>(args)...);
+    guard.pool = nullptr;
+
+    ++s.generation;
+    ++m_size;
+    return Handle{index, s.generation};
+  }
+
+  Optional<T&> get(Handle handle) noexcept
+  {
+    if(handle.index >= m_used || slot(handle.index).generation != handle.generation || !(handle.generation & 1u))
+      return Optional<T&>();
+
+    return Optional<T&>(slot(handle.index).value);
+  }
+
+  Optional<const T&> get(Handle handle) const noexcept
+  {
+    if(handle.index >= m_used || slot(handle.index).generation != handle.generation || !(handle.generation & 1u))
+      return Optional<const T&>();
+
+    return Optional<const T&>(slot(handle.index).value);
+  }
+
+  bool contains(Handle handle) const noexcept { return get(handle).has_value(); }
+
+  // false for a stale handle
+  bool erase(Handle handle) noexcept(detail::is_noexcept_destructible<T>::value)
+  {
+    if(!contains(handle))
+      return false;
+
+    release(handle.index);
+    return true;
+  }
+
+  // every outstanding handle goes stale, the chunks are kept
+  void clear() noexcept(detail::is_noexcept_destructible<T>::value)
+  {
+    for(uint32_t i = 0; i < m_used; ++i)
+    {
+      if(slot(i).engaged())
+        release(i);
+    }
+  }
+
+  // f(handle, value) for every object, in slot order
+  template<typename F>
+  void for_each(F &&f)
+  {
+    for(uint32_t i = 0; i < m_used; ++i)
+    {
+      Slot &s = slot(i);
+      if(s.engaged())
+        f(Handle{i, s.generation}, s.value);
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,361 @@
+/*
+*  MIT License
+*  
+*  Copyright (c) 2025 Pawel Drzycimski
+*  
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*  
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+*  
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*
+*/
+
+#ifndef PDY_SMALL_OPTIONAL_VECTOR_HPP_
+#define PDY_SMALL_OPTIONAL_VECTOR_HPP_
+
+#include "Optional.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/*
+*  SmallOptionalVector<T, N> is a vector of Optional<T> keeping the first N elements inline,
+*  it goes to the heap only once it grows past N.
+*
+*  Slots past size() are raw memory, an element comes to life when pushed, engaged or not.
+*  Destroying elements is skipped altogether when Optional<T> is trivially destructible,
+*  which is the case when T is: optional_storage picks the trivial destructor then.
+*
+*  Growing and moving an inline vector relocate the elements. For T marked trivially
+*  relocatable that is a memcpy, otherwise a move construction (a copy when the move can
+*  throw and T is copyable) of every element, then the destruction of the old ones. If
+*  building an element throws, the old elements are left in place and the new buffer is freed.
+*  Trivially copyable types are marked already, others can opt in:
+*
+*  template<> struct detail::is_trivially_relocatable<MyHandle> : std::true_type {};
+*/
+
+namespace detail {
+
+template<typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+} // namespace detail
+
+template<typename T, size_t N>
+class SmallOptionalVector final
+{
+  static_assert(N > 0, "use std::vector<Optional<T>> for no inline slots");
+
+  using Elem = Optional<T>;
+
+  static constexpr bool TRIVIAL_DTOR = std::is_trivially_destructible<Elem>::value;
+  static constexpr bool TRIVIAL_RELOCATE = detail::is_trivially_relocatable<T>::value;
+
+  Elem *m_data;
+  size_t m_size = 0;
+  size_t m_capacity = N;
+  alignas(Elem) unsigned char m_inline[N * sizeof(Elem)];
+
+  Elem* inline_data() noexcept { return reinterpret_cast<Elem*>(m_inline); }
+
+  static void destroy(Elem *first, Elem *last) noexcept(detail::is_noexcept_destructible<T>::value)
+  {
+    if(TRIVIAL_DTOR)
+      return;
+
+    for(; first != last; ++first)
+      first->~Elem();
+  }
+
+  // copying when T's move can throw and T can be copied, as std::move_if_noexcept on T would
+  using RelocateSource = typename std::conditional<
+    detail::is_noxcept_move_constructible<T>::value || !std::is_copy_constructible<T>::value,
+    Elem&&, const Elem&>::type;
+
+  // during unwinding destroys the elements built so far at dst and frees dst when it is a
+  // heap buffer, unless 'dst' was cleared
+  struct RelocateGuard
+  {
+    Elem *dst;
+    size_t built;
+    bool heap;
+
+    ~RelocateGuard()
+    {
+      if(!dst)
+        return;
+
+      destroy(dst, dst + built);
+      if(heap)
+        ::operator delete(dst);
+    }
+  };
+
+  // moves [src, src + count) into raw memory at dst, src is raw memory afterwards.
+  // src is only destroyed once every element is built at dst: a throw leaves every src
+  // element alive, unchanged when copied and moved from when T has only a throwing move
+  static void relocate(Elem *src, size_t count, Elem *dst, bool heap)
+  {
+    if(TRIVIAL_RELOCATE)
+    {
+      if(count)
+        std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(Elem));
+
+      return;
+    }
+
+    RelocateGuard guard{dst, 0, heap};
+    for(; guard.built < count; ++guard.built)
+      ::new(static_cast<void*>(dst + guard.built)) Elem(static_cast<RelocateSource>(src[guard.built]));
+
+    guard.dst = nullptr;
+    destroy(src, src + count);
+  }
+
+  void grow(size_t minCapacity)
+  {
+    size_t capacity = m_capacity * 2;
+    if(capacity < minCapacity)
+      capacity = minCapacity;
+
+    Elem *data = static_cast<Elem*>(::operator new(capacity * sizeof(Elem)));
+    relocate(m_data, m_size, data, true);
+
+    if(!is_inline())
+      ::operator delete(m_data);
+
+    m_data = data;
+    m_capacity = capacity;
+  }
+
+  void free_heap() noexcept
+  {
+    if(!is_inline())
+      ::operator delete(m_data);
+
+    m_data = inline_data();
+    m_capacity = N;
+  }
+
+  void steal(SmallOptionalVector<T, N> &other)
+  {
+    if(other.is_inline())
+    {
+      relocate(other.m_data, other.m_size, m_data, false);
+      m_size = other.m_size;
+    }
+    else
+    {
+      m_data = other.m_data;
+      m_size = other.m_size;
+      m_capacity = other.m_capacity;
+    }
+
+    other.m_data = other.inline_data();
+    other.m_size = 0;
+    other.m_capacity = N;
+  }
+
+public:
+  SmallOptionalVector() noexcept
+    : m_data{inline_data()}
+  {}
+
+  SmallOptionalVector(std::initializer_list<Elem> init)
+    : m_data{inline_data()}
+  {
+    reserve(init.size());
+    for(const auto &opt : init)
+      push_back(opt);
+  }
+
+  SmallOptionalVector(const SmallOptionalVector<T, N> &other)
+    : m_data{inline_data()}
+  {
+    reserve(other.m_size);
+    for(size_t i = 0; i < other.m_size; ++i)
+      push_back(other.m_data[i]);
+  }
+
+  SmallOptionalVector(SmallOptionalVector<T, N> &&other)
+    noexcept(TRIVIAL_RELOCATE || detail::is_noxcept_move_constructible<T>::value)
+    : m_data{inline_data()}
+  {
+    steal(other);
+  }
+
+  SmallOptionalVector<T, N>& operator=(const SmallOptionalVector<T, N> &other)
+  {
+    if(this != &other)
+    {
+      clear();
+      reserve(other.m_size);
+      for(size_t i = 0; i < other.m_size; ++i)
+        push_back(other.m_data[i]);
+    }
+
+    return *this;
+  }
+
+  SmallOptionalVector<T, N>& operator=(SmallOptionalVector<T, N> &&other)
+    noexcept(TRIVIAL_RELOCATE || detail::is_noxcept_move_constructible<T>::value)
+  {
+    if(this != &other)
+    {
+      clear();
+      free_heap();
+      steal(other);
+    }
+
+    return *this;
+  }
+
+  ~SmallOptionalVector()
+  {
+    clear();
+    free_heap();
+  }
+
+  size_t size() const noexcept { return m_size; }
+  size_t capacity() const noexcept { return m_capacity; }
+  bool empty() const noexcept { return m_size == 0; }
+  bool is_inline() const noexcept { return m_data == reinterpret_cast<const Elem*>(m_inline); }
+
+  Elem& operator[](size_t idx) noexcept { assert(idx < m_size); return m_data[idx]; }
+  const Elem& operator[](size_t idx) const noexcept { assert(idx < m_size); return m_data[idx]; }
+
+  Elem& back() noexcept { assert(m_size > 0); return m_data[m_size - 1]; }
+  const Elem& back() const noexcept { assert(m_size > 0); return m_data[m_size - 1]; }
+
+  Elem* begin() noexcept { return m_data; }
+  Elem* end() noexcept { return m_data + m_size; }
+  const Elem* begin() const noexcept { return m_data; }
+  const Elem* end() const noexcept { return m_data + m_size; }
+
+  void reserve(size_t capacity)
+  {
+    if(capacity > m_capacity)
+      grow(capacity);
+  }
+
+  void push_back(const Elem &opt)
+  {
+    if(m_size == m_capacity)
+    {
+      // opt may live in this vector, copy it before the storage moves
+      Elem copy(opt);
+      grow(m_size + 1);
+      ::new(static_cast<void*>(m_data + m_size)) Elem(std::move(copy));
+    }
+    else
+    {
+      ::new(static_cast<void*>(m_data + m_size)) Elem(opt);
+    }
+
+    ++m_size;
+  }
+
+  void push_back(Elem &&opt)
+  {
+    if(m_size == m_capacity)
+    {
+      Elem moved(std::move(opt));
+      grow(m_size + 1);
+      ::new(static_cast<void*>(m_data + m_size)) Elem(std::move(moved));
+    }
+    else
+    {
+      ::new(static_cast<void*>(m_data + m_size)) Elem(std::move(opt));
+    }
+
+    ++m_size;
+  }
+
+  // appends an engaged element built from args
+  template<typename ...Args>
+  Elem& emplace_back(Args&& ...args)
+  {
+    if(m_size == m_capacity)
+    {
+      // args may refer into this vector, build the value before the storage moves
+      T value(std::forward<Args>(args)...);
+      grow(m_size + 1);
+      ::new(static_cast<void*>(m_data + m_size)) Elem(std::move(value));
+    }
+    else
+    {
+      // T built right in its slot, no temporary to move from
+      Elem *elem = ::new(static_cast<void*>(m_data + m_size)) Elem();
+      auto &storage = detail::optional_access::storage(*elem);
+      ::new(static_cast<void*>(std::addressof(storage.value))) T(std::forward<Args>(args)...);
+      storage.engaged = true;
+    }
+
+    return m_data[m_size++];
+  }
+
+  void pop_back() noexcept(detail::is_noexcept_destructible<T>::value)
+  {
+    assert(m_size > 0);
+    --m_size;
+    destroy(m_data + m_size, m_data + m_size + 1);
+  }
+
+  // new elements are empty
+  void resize(size_t size)
+  {
+    if(size < m_size)
+    {
+      destroy(m_data + size, m_data + m_size);
+      m_size = size;
+      return;
+    }
+
+    reserve(size);
+    for(; m_size < size; ++m_size)
+      ::new(static_cast<void*>(m_data + m_size)) Elem();
+  }
+
+  // keeps the size, every element ends up empty
+  void reset_all() noexcept(detail::is_noexcept_destructible<T>::value)
+  {
+    if(TRIVIAL_DTOR)
+    {
+      for(size_t i = 0; i < m_size; ++i)
+        ::new(static_cast<void*>(m_data + i)) Elem();
+
+      return;
+    }
+
+    for(size_t i = 0; i < m_size; ++i)
+      m_data[i].reset();
+  }
+
+  // keeps the capacity
+  void clear() noexcept(detail::is_noexcept_destructible<T>::value)
+  {
+    destroy(m_data, m_data + m_size);
+    m_size = 0;
+  }
+};
+
+#endif
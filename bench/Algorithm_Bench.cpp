@@ -0,0 +1,114 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <OptionalAlgorithm.hpp>
+
+#include "Bench.hpp"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t COUNT = 1 << 24;
+
+template<typename Policy>
+void run(const char *policyName, const Policy &policy, const std::vector<Optional<int64_t>> &span, const OptionalArray<int64_t> &array)
+{
+  char name[96];
+  const auto square = [](int64_t v) { return v * v; };
+  const auto plus = [](int64_t a, int64_t b) { return a + b; };
+
+  std::snprintf(name, sizeof(name), "%s span transform_reduce", policyName);
+  bench::report(name, bench::ns_per_op(1, [&](size_t) {
+    bench::do_not_optimize(optional_transform_reduce(policy, span.data(), COUNT, int64_t{0}, plus, square));
+  }) / COUNT);
+
+  std::snprintf(name, sizeof(name), "%s bitmap transform_reduce", policyName);
+  bench::report(name, bench::ns_per_op(1, [&](size_t) {
+    bench::do_not_optimize(optional_transform_reduce(policy, array, int64_t{0}, plus, square));
+  }) / COUNT);
+
+  std::snprintf(name, sizeof(name), "%s span count", policyName);
+  bench::report(name, bench::ns_per_op(1, [&](size_t) {
+    bench::do_not_optimize(optional_count(policy, span.data(), COUNT));
+  }) / COUNT);
+
+  std::snprintf(name, sizeof(name), "%s bitmap count", policyName);
+  bench::report(name, bench::ns_per_op(1, [&](size_t) {
+    bench::do_not_optimize(optional_count(policy, array));
+  }) / COUNT);
+
+  std::vector<Optional<int64_t>> out(COUNT);
+  std::snprintf(name, sizeof(name), "%s span transform", policyName);
+  bench::report(name, bench::ns_per_op(1, [&](size_t) {
+    optional_transform(policy, span.data(), COUNT, out.data(), square);
+    bench::do_not_optimize(out.data());
+  }) / COUNT);
+
+  std::snprintf(name, sizeof(name), "%s span compact", policyName);
+  bench::report(name, bench::ns_per_op(1, [&](size_t) {
+    bench::do_not_optimize(compact(policy, span.data(), COUNT).size());
+  }) / COUNT);
+
+  std::snprintf(name, sizeof(name), "%s bitmap compact", policyName);
+  bench::report(name, bench::ns_per_op(1, [&](size_t) {
+    bench::do_not_optimize(compact(policy, array).size());
+  }) / COUNT);
+}
+
+} // namespace
+
+int main()
+{
+  bench::Rng rng;
+  std::vector<Optional<int64_t>> span(COUNT);
+  OptionalArray<int64_t> array(COUNT);
+  for(size_t i = 0; i < COUNT; ++i)
+  {
+    if(rng.chance(50))
+    {
+      const auto val = static_cast<int64_t>(rng.next() % 1000);
+      span[i] = val;
+      array.set(i, val);
+    }
+  }
+
+  std::printf("per element timings, 50%% engaged, %u hardware threads\n", std::thread::hardware_concurrency());
+
+  run("sequential", SequentialPolicy{}, span, array);
+
+  for(const unsigned threads : {1u, 2u, 4u, 8u, 16u, 32u})
+  {
+    if(threads > 2 * std::thread::hardware_concurrency())
+      break;
+
+    char policyName[32];
+    std::snprintf(policyName, sizeof(policyName), "parallel(%u)", threads);
+    run(policyName, ParallelPolicy{threads}, span, array);
+  }
+
+  return 0;
+}
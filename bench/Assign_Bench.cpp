@@ -0,0 +1,112 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <Optional.hpp>
+
+#include "Bench.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr size_t ITERATIONS = 200000;
+
+// what operator= used to do: materialize a copy of 'other' and swap it in
+template<typename T>
+void copy_and_swap_assign(Optional<T> &lhs, const Optional<T> &rhs)
+{
+  Optional<T> tmp{rhs};
+  swap(lhs, tmp);
+}
+
+template<typename T>
+void move_and_swap_assign(Optional<T> &lhs, Optional<T> &&rhs)
+{
+  Optional<T> tmp{std::move(rhs)};
+  swap(lhs, tmp);
+}
+
+template<typename T>
+void run(const char *copySwapName, const char *copyName, const char *moveSwapName, const char *moveName, const T &payload)
+{
+  {
+    Optional<T> lhs{payload};
+    const Optional<T> rhs{payload};
+    bench::report(copySwapName, bench::ns_per_op(ITERATIONS, [&](size_t) {
+      copy_and_swap_assign(lhs, rhs);
+      bench::do_not_optimize(lhs);
+    }));
+  }
+
+  {
+    Optional<T> lhs{payload};
+    const Optional<T> rhs{payload};
+    bench::report(copyName, bench::ns_per_op(ITERATIONS, [&](size_t) {
+      lhs = rhs;
+      bench::do_not_optimize(lhs);
+    }));
+  }
+
+  // the refill of the source is part of both loops so they stay comparable
+  {
+    Optional<T> lhs{payload};
+    Optional<T> rhs{payload};
+    bench::report(moveSwapName, bench::ns_per_op(ITERATIONS, [&](size_t) {
+      move_and_swap_assign(lhs, std::move(rhs));
+      rhs = lhs;
+      bench::do_not_optimize(lhs);
+    }));
+  }
+
+  {
+    Optional<T> lhs{payload};
+    Optional<T> rhs{payload};
+    bench::report(moveName, bench::ns_per_op(ITERATIONS, [&](size_t) {
+      lhs = std::move(rhs);
+      rhs = lhs;
+      bench::do_not_optimize(lhs);
+    }));
+  }
+}
+
+} // namespace
+
+int main()
+{
+  run("vector<int>(256) copy-and-swap", "vector<int>(256) copy-assign",
+      "vector<int>(256) move-and-swap", "vector<int>(256) move-assign",
+      std::vector<int>(256, 7));
+
+  run("string(200) copy-and-swap", "string(200) copy-assign",
+      "string(200) move-and-swap", "string(200) move-assign",
+      std::string(200, 'x'));
+
+  run("string(8) copy-and-swap", "string(8) copy-assign",
+      "string(8) move-and-swap", "string(8) move-assign",
+      std::string(8, 'x'));
+
+  return 0;
+}
@@ -0,0 +1,122 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <OptionalBatch.hpp>
+
+#include "Bench.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t COUNT = 1 << 20;
+
+struct Big
+{
+  int64_t id;
+  char payload[248];
+};
+
+template<typename T>
+void run(const char *typeName, const T &value, unsigned density)
+{
+  bench::Rng rng{density};
+  std::vector<Optional<T>> opts(COUNT);
+  std::vector<bool> engaged(COUNT);
+  for(size_t i = 0; i < COUNT; ++i)
+    engaged[i] = rng.chance(density);
+
+  const auto refill = [&] {
+    for(size_t i = 0; i < COUNT; ++i)
+    {
+      if(engaged[i])
+        opts[i] = value;
+    }
+  };
+
+  char name[96];
+  double total = 0.0;
+  for(unsigned run = 0; run < 3; ++run)
+  {
+    refill();
+    const double ns = bench::ns_per_op(1, [&](size_t) {
+      for(auto &opt : opts)
+        opt.reset();
+    }, 1);
+    total = run == 0 || ns < total ? ns : total;
+  }
+  std::snprintf(name, sizeof(name), "%-7s %3u%% engaged  reset() per element", typeName, density);
+  bench::report(name, total / COUNT);
+
+  for(unsigned run = 0; run < 3; ++run)
+  {
+    refill();
+    const double ns = bench::ns_per_op(1, [&](size_t) {
+      reset_all(opts.data(), opts.size());
+    }, 1);
+    total = run == 0 || ns < total ? ns : total;
+  }
+  std::snprintf(name, sizeof(name), "%-7s %3u%% engaged  reset_all", typeName, density);
+  bench::report(name, total / COUNT);
+
+  std::snprintf(name, sizeof(name), "%-7s %3u%% engaged  assignment per element", typeName, density);
+  bench::report(name, bench::ns_per_op(1, [&](size_t) {
+    for(auto &opt : opts)
+      opt = value;
+  }, 3) / COUNT);
+
+  std::snprintf(name, sizeof(name), "%-7s %3u%% engaged  fill_engaged", typeName, density);
+  bench::report(name, bench::ns_per_op(1, [&](size_t) {
+    fill_engaged(opts.data(), opts.size(), value);
+  }, 3) / COUNT);
+}
+
+} // namespace
+
+int main()
+{
+  std::printf("ns per element, %zu elements\n", COUNT);
+
+  for(const unsigned density : {10u, 50u, 90u})
+  {
+    run<int64_t>("int64", 42, density);
+    run<Big>("Big", Big{1, {}}, density);
+    run<std::string>("string", std::string(40, 's'), density);
+  }
+
+  std::vector<unsigned char> raw(COUNT * sizeof(Optional<int64_t>));
+  auto *first = reinterpret_cast<Optional<int64_t>*>(raw.data());
+  bench::report("int64   construction loop", bench::ns_per_op(1, [&](size_t) {
+    for(size_t i = 0; i < COUNT; ++i)
+      ::new(static_cast<void*>(first + i)) Optional<int64_t>();
+  }) / COUNT);
+
+  bench::report("int64   uninitialized_default_n", bench::ns_per_op(1, [&](size_t) {
+    uninitialized_default_n(first, COUNT);
+  }) / COUNT);
+
+  return 0;
+}
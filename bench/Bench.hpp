@@ -0,0 +1,105 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#ifndef PDY_OPTIONAL_BENCH_HPP_
+#define PDY_OPTIONAL_BENCH_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+namespace bench {
+
+template<typename T>
+inline void do_not_optimize(const T &val)
+{
+  asm volatile("" : : "r,m"(val) : "memory");
+}
+
+inline void clobber()
+{
+  asm volatile("" : : : "memory");
+}
+
+// best of 'runs' repetitions, in nanoseconds per single call of 'op'
+template<typename Op>
+double ns_per_op(size_t iterations, Op &&op, unsigned runs = 5)
+{
+  using Clock = std::chrono::steady_clock;
+
+  double best = 0.0;
+  for(unsigned run = 0; run < runs; ++run)
+  {
+    const auto start = Clock::now();
+    for(size_t i = 0; i < iterations; ++i)
+      op(i);
+    clobber();
+    const auto end = Clock::now();
+
+    const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    const double perOp = ns / static_cast<double>(iterations);
+    if(run == 0 || perOp < best)
+      best = perOp;
+  }
+
+  return best;
+}
+
+inline void report(const char *name, double nsPerOp)
+{
+  std::printf("%-56s %12.3f ns/op\n", name, nsPerOp);
+}
+
+inline void report_throughput(const char *name, double bytes, double ns)
+{
+  std::printf("%-56s %12.3f GB/s\n", name, bytes / ns);
+}
+
+// xorshift, good enough to defeat the branch predictor
+struct Rng
+{
+  unsigned long long state;
+
+  explicit Rng(unsigned long long seed = 0x9E3779B97F4A7C15ull)
+    : state{seed}
+  {}
+
+  unsigned long long next()
+  {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+
+  bool chance(unsigned percent)
+  {
+    return next() % 100 < percent;
+  }
+};
+
+} // namespace bench
+
+#endif
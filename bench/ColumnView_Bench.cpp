@@ -0,0 +1,108 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <OptionalColumnView.hpp>
+
+#include "Bench.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+constexpr size_t COUNT = 1 << 23;
+constexpr size_t LOOKUPS = 1 << 20;
+
+const char *PATH = "/tmp/ColumnView_Bench.bin";
+
+void write_file(unsigned engagedPercent)
+{
+  bench::Rng rng;
+  std::vector<Optional<int64_t>> column(COUNT);
+  for(auto &opt : column)
+  {
+    if(rng.chance(engagedPercent))
+      opt = static_cast<int64_t>(rng.next());
+  }
+
+  std::FILE *file = std::fopen(PATH, "wb");
+  OptionalFileSink sink{file};
+  OptionalWriter<OptionalFileSink> writer{sink};
+  writer.write(column);
+  std::fclose(file);
+}
+
+void run(unsigned engagedPercent)
+{
+  write_file(engagedPercent);
+
+  char name[96];
+
+  std::snprintf(name, sizeof(name), "%u%% engaged, load into vector<Optional>", engagedPercent);
+  bench::report(name, bench::ns_per_op(1, [&](size_t) {
+    std::vector<Optional<int64_t>> column;
+    std::FILE *file = std::fopen(PATH, "rb");
+    OptionalFileSource source{file};
+    OptionalReader<OptionalFileSource> reader{source};
+    reader.read(column);
+    std::fclose(file);
+    bench::do_not_optimize(column.data());
+  }));
+
+  std::snprintf(name, sizeof(name), "%u%% engaged, open OptionalColumnView", engagedPercent);
+  bench::report(name, bench::ns_per_op(1, [&](size_t) {
+    OptionalColumnView<int64_t> view;
+    view.open(PATH);
+    bench::do_not_optimize(view.count());
+  }));
+
+  OptionalColumnView<int64_t> view;
+  view.open(PATH);
+
+  std::snprintf(name, sizeof(name), "%u%% engaged, view random operator[]", engagedPercent);
+  bench::Rng rng;
+  bench::report(name, bench::ns_per_op(LOOKUPS, [&](size_t) {
+    bench::do_not_optimize(view[rng.next() % COUNT].value_or(0));
+  }));
+
+  std::snprintf(name, sizeof(name), "%u%% engaged, view for_each_engaged per element", engagedPercent);
+  bench::report(name, bench::ns_per_op(1, [&](size_t) {
+    int64_t sum = 0;
+    view.for_each_engaged([&](size_t, int64_t val) { sum += val; });
+    bench::do_not_optimize(sum);
+  }) / COUNT);
+}
+
+} // namespace
+
+int main()
+{
+  run(10);
+  run(50);
+  run(90);
+
+  std::remove(PATH);
+  return 0;
+}
@@ -0,0 +1,109 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <OptionalCompact.hpp>
+
+#include "Bench.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+constexpr size_t COUNT = 1 << 22;
+
+template<typename T>
+size_t branching_compact(const Optional<T> *in, size_t n, T *out, uint32_t *idxOut)
+{
+  size_t k = 0;
+  for(size_t i = 0; i < n; ++i)
+  {
+    if(in[i])
+    {
+      out[k] = *in[i];
+      idxOut[k] = static_cast<uint32_t>(i);
+      ++k;
+    }
+  }
+
+  return k;
+}
+
+template<typename T>
+void run(const char *typeName, unsigned density)
+{
+  bench::Rng rng{density + 1};
+  std::vector<Optional<T>> span(COUNT);
+  OptionalArray<T> array(COUNT);
+  for(size_t i = 0; i < COUNT; ++i)
+  {
+    if(rng.chance(density))
+    {
+      const auto val = static_cast<T>(rng.next() % 1000);
+      span[i] = val;
+      array.set(i, val);
+    }
+  }
+
+  std::vector<T> values(COUNT);
+  std::vector<uint32_t> idx(COUNT);
+  char name[96];
+
+  std::snprintf(name, sizeof(name), "%s %3u%% branching loop", typeName, density);
+  bench::report(name, bench::ns_per_op(1, [&](size_t) {
+    bench::do_not_optimize(branching_compact(span.data(), COUNT, values.data(), idx.data()));
+  }) / COUNT);
+
+  std::snprintf(name, sizeof(name), "%s %3u%% compact span", typeName, density);
+  bench::report(name, bench::ns_per_op(1, [&](size_t) {
+    bench::do_not_optimize(compact(span.data(), COUNT, values.data(), idx.data()));
+  }) / COUNT);
+
+  std::snprintf(name, sizeof(name), "%s %3u%% compact bitmap", typeName, density);
+  bench::report(name, bench::ns_per_op(1, [&](size_t) {
+    bench::do_not_optimize(compact(array, values.data(), idx.data()));
+  }) / COUNT);
+
+  const size_t count = compact(span.data(), COUNT, values.data(), idx.data());
+  std::snprintf(name, sizeof(name), "%s %3u%% expand span", typeName, density);
+  bench::report(name, bench::ns_per_op(1, [&](size_t) {
+    expand(values.data(), idx.data(), count, span.data(), COUNT);
+    bench::clobber();
+  }) / COUNT);
+}
+
+} // namespace
+
+int main()
+{
+  std::printf("per element timings\n");
+
+  for(const unsigned density : {1u, 10u, 50u, 90u, 100u})
+  {
+    run<int32_t>("int32", density);
+    run<double>("double", density);
+  }
+
+  return 0;
+}
@@ -0,0 +1,121 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <OptionalCoro.hpp>
+
+#include "Bench.hpp"
+
+#include <vector>
+
+namespace {
+
+constexpr size_t COUNT = 1 << 16;
+constexpr size_t ITERATIONS = 1 << 22;
+
+struct Input
+{
+  Optional<int> a, b, c, d;
+};
+
+__attribute__((noinline)) Optional<int> step(const Optional<int> &val, int mul)
+{
+  if(!val)
+    return {};
+
+  return *val * mul;
+}
+
+Optional<int> chain_if(const Input &in)
+{
+  const auto a = step(in.a, 2);
+  if(!a)
+    return {};
+
+  const auto b = step(in.b, 3);
+  if(!b)
+    return {};
+
+  const auto c = step(in.c, 5);
+  if(!c)
+    return {};
+
+  const auto d = step(in.d, 7);
+  if(!d)
+    return {};
+
+  return *a + *b + *c + *d;
+}
+
+Optional<int> chain_coro(const Input &in)
+{
+  const int a = co_await step(in.a, 2);
+  const int b = co_await step(in.b, 3);
+  const int c = co_await step(in.c, 5);
+  const int d = co_await step(in.d, 7);
+  co_return a + b + c + d;
+}
+
+std::vector<Input> make_inputs(unsigned emptyPercent)
+{
+  bench::Rng rng;
+  std::vector<Input> ret(COUNT);
+  for(auto &in : ret)
+  {
+    for(Optional<int> *opt : {&in.a, &in.b, &in.c, &in.d})
+    {
+      if(!rng.chance(emptyPercent))
+        *opt = static_cast<int>(rng.next() % 1000);
+    }
+  }
+
+  return ret;
+}
+
+void run(unsigned emptyPercent)
+{
+  const auto inputs = make_inputs(emptyPercent);
+
+  char name[64];
+
+  std::snprintf(name, sizeof(name), "if-chain, %u%% empty per step", emptyPercent);
+  bench::report(name, bench::ns_per_op(ITERATIONS, [&](size_t i) {
+    bench::do_not_optimize(chain_if(inputs[i % COUNT]));
+  }));
+
+  std::snprintf(name, sizeof(name), "co_await chain, %u%% empty per step", emptyPercent);
+  bench::report(name, bench::ns_per_op(ITERATIONS, [&](size_t i) {
+    bench::do_not_optimize(chain_coro(inputs[i % COUNT]));
+  }));
+}
+
+} // namespace
+
+int main()
+{
+  run(0);
+  run(10);
+  run(50);
+
+  return 0;
+}
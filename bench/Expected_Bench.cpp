@@ -0,0 +1,118 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <Expected.hpp>
+
+#include "Bench.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+constexpr size_t COUNT = 1 << 16;
+
+enum class Errc : uint8_t
+{
+  Invalid
+};
+
+struct ParseError : std::runtime_error
+{
+  ParseError()
+    : std::runtime_error("invalid digit")
+  {}
+};
+
+// calls are kept out of line, as a parser or an I/O call would be
+__attribute__((noinline)) Expected<int, Errc> parse_expected(char c)
+{
+  if(c < '0' || c > '9')
+    return make_unexpected(Errc::Invalid);
+
+  return c - '0';
+}
+
+__attribute__((noinline)) int parse_throwing(char c)
+{
+  if(c < '0' || c > '9')
+    throw ParseError();
+
+  return c - '0';
+}
+
+__attribute__((noinline)) Optional<int> parse_optional(char c)
+{
+  if(c < '0' || c > '9')
+    return Optional<int>();
+
+  return c - '0';
+}
+
+void run(unsigned errorPercent)
+{
+  bench::Rng rng{errorPercent + 1};
+  std::vector<char> input(COUNT);
+  for(auto &c : input)
+    c = rng.chance(errorPercent) ? 'x' : static_cast<char>('0' + rng.next() % 10);
+
+  char name[96];
+
+  std::snprintf(name, sizeof(name), "%3u%% errors  Expected<int, Errc>", errorPercent);
+  bench::report(name, bench::ns_per_op(COUNT, [&](size_t i) {
+    const auto res = parse_expected(input[i]);
+    bench::do_not_optimize(res ? *res : -static_cast<int>(res.error()));
+  }));
+
+  std::snprintf(name, sizeof(name), "%3u%% errors  Optional<int>", errorPercent);
+  bench::report(name, bench::ns_per_op(COUNT, [&](size_t i) {
+    const auto res = parse_optional(input[i]);
+    bench::do_not_optimize(res.value_or(-1));
+  }));
+
+  std::snprintf(name, sizeof(name), "%3u%% errors  throw/catch", errorPercent);
+  bench::report(name, bench::ns_per_op(COUNT, [&](size_t i) {
+    int res;
+    try
+    {
+      res = parse_throwing(input[i]);
+    }
+    catch(const ParseError&)
+    {
+      res = -1;
+    }
+    bench::do_not_optimize(res);
+  }));
+}
+
+} // namespace
+
+int main()
+{
+  for(const unsigned errorPercent : {0u, 1u, 10u, 50u, 100u})
+    run(errorPercent);
+
+  return 0;
+}
@@ -0,0 +1,133 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <OptionalIndex.hpp>
+
+#include "Bench.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr size_t COUNT = 1 << 22;
+constexpr size_t LOOKUPS = 1 << 20;
+
+size_t g_allocated = 0;
+
+// tracks the hash map's nodes and buckets
+template<typename T>
+struct CountingAllocator
+{
+  using value_type = T;
+
+  CountingAllocator() = default;
+
+  template<typename U>
+  CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+  T* allocate(size_t n)
+  {
+    g_allocated += n * sizeof(T);
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T *ptr, size_t n) noexcept
+  {
+    g_allocated -= n * sizeof(T);
+    std::allocator<T>().deallocate(ptr, n);
+  }
+
+  template<typename U>
+  bool operator==(const CountingAllocator<U>&) const noexcept { return true; }
+
+  template<typename U>
+  bool operator!=(const CountingAllocator<U>&) const noexcept { return false; }
+};
+
+using HashMap = std::unordered_map<uint32_t, int64_t, std::hash<uint32_t>, std::equal_to<uint32_t>,
+  CountingAllocator<std::pair<const uint32_t, int64_t>>>;
+
+void run(unsigned engagedPerMille)
+{
+  bench::Rng rng{engagedPerMille + 1};
+
+  std::vector<Optional<int64_t>> dense(COUNT);
+  OptionalIndexBuilder<int64_t> builder;
+  g_allocated = 0;
+  HashMap map;
+  for(size_t i = 0; i < COUNT; ++i)
+  {
+    if(rng.next() % 1000 < engagedPerMille)
+    {
+      const auto val = static_cast<int64_t>(rng.next() % 1000);
+      dense[i] = val;
+      map.emplace(static_cast<uint32_t>(i), val);
+    }
+    builder.push_back(dense[i]);
+  }
+  const auto index = std::move(builder).build();
+  const size_t mapBytes = g_allocated;
+
+  std::vector<uint32_t> lookups(LOOKUPS);
+  for(auto &idx : lookups)
+    idx = static_cast<uint32_t>(rng.next() % COUNT);
+
+  std::printf("%.1f%% engaged, memory MB: vector %.2f  hash map %.2f  OptionalIndex %.2f\n",
+      engagedPerMille / 10.0,
+      static_cast<double>(dense.capacity() * sizeof(Optional<int64_t>)) / 1e6,
+      static_cast<double>(mapBytes) / 1e6,
+      static_cast<double>(index.memory_usage()) / 1e6);
+
+  char name[96];
+  std::snprintf(name, sizeof(name), "%5.1f%%  random at()  std::vector<Optional<T>>", engagedPerMille / 10.0);
+  bench::report(name, bench::ns_per_op(LOOKUPS, [&](size_t i) {
+    const auto &opt = dense[lookups[i]];
+    bench::do_not_optimize(opt ? *opt : 0);
+  }));
+
+  std::snprintf(name, sizeof(name), "%5.1f%%  random at()  unordered_map", engagedPerMille / 10.0);
+  bench::report(name, bench::ns_per_op(LOOKUPS, [&](size_t i) {
+    const auto it = map.find(lookups[i]);
+    bench::do_not_optimize(it != map.end() ? it->second : 0);
+  }));
+
+  std::snprintf(name, sizeof(name), "%5.1f%%  random at()  OptionalIndex", engagedPerMille / 10.0);
+  bench::report(name, bench::ns_per_op(LOOKUPS, [&](size_t i) {
+    const auto opt = index.at(lookups[i]);
+    bench::do_not_optimize(opt ? *opt : 0);
+  }));
+}
+
+} // namespace
+
+int main()
+{
+  for(const unsigned perMille : {1u, 10u, 100u, 500u})
+    run(perMille);
+
+  return 0;
+}
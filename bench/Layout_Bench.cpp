@@ -0,0 +1,118 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <Optional.hpp>
+
+#include "Bench.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+// the same 248 byte record twice, only the Optional layout differs
+struct ColdRecord
+{
+  int64_t id;
+  char payload[240];
+};
+
+struct HotRecord
+{
+  int64_t id;
+  char payload[240];
+};
+
+} // namespace
+
+namespace detail {
+
+template<>
+struct optional_flag_first<HotRecord> : std::true_type {};
+
+} // namespace detail
+
+namespace {
+
+constexpr size_t COUNT = 1 << 19;
+
+template<typename Record>
+void run(const char *layoutName, const std::vector<uint32_t> &order, unsigned density)
+{
+  bench::Rng rng{density};
+  std::vector<Optional<Record>> records(COUNT);
+  for(size_t i = 0; i < COUNT; ++i)
+  {
+    if(rng.chance(density))
+      records[i] = Record{static_cast<int64_t>(i), {}};
+  }
+
+  char name[96];
+  std::snprintf(name, sizeof(name), "%3u%% engaged  random    %s", density, layoutName);
+  bench::report(name, bench::ns_per_op(1, [&](size_t) {
+    int64_t sum = 0;
+    for(const uint32_t idx : order)
+    {
+      const auto &rec = records[idx];
+      if(rec)
+        sum += rec->id;
+    }
+    bench::do_not_optimize(sum);
+  }) / COUNT);
+
+  std::snprintf(name, sizeof(name), "%3u%% engaged  in order  %s", density, layoutName);
+  bench::report(name, bench::ns_per_op(1, [&](size_t) {
+    int64_t sum = 0;
+    for(const auto &rec : records)
+    {
+      if(rec)
+        sum += rec->id;
+    }
+    bench::do_not_optimize(sum);
+  }) / COUNT);
+}
+
+} // namespace
+
+int main()
+{
+  static_assert(sizeof(Optional<ColdRecord>) == sizeof(Optional<HotRecord>), "same size, different layout");
+
+  bench::Rng rng;
+  std::vector<uint32_t> order(COUNT);
+  for(size_t i = 0; i < COUNT; ++i)
+    order[i] = static_cast<uint32_t>(i);
+  for(size_t i = COUNT - 1; i > 0; --i)
+    std::swap(order[i], order[rng.next() % (i + 1)]);
+
+  std::printf("ns per element, %zu Optional<248 byte record>, %zu MB\n", COUNT, COUNT * sizeof(Optional<ColdRecord>) >> 20);
+
+  for(const unsigned density : {10u, 50u, 90u})
+  {
+    run<ColdRecord>("flag after payload", order, density);
+    run<HotRecord>("flag first", order, density);
+  }
+
+  return 0;
+}
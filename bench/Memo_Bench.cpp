@@ -0,0 +1,161 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <Memo.hpp>
+
+#include "Bench.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr size_t CAPACITY = 1 << 16;
+constexpr size_t KEY_RANGE = CAPACITY * 2; // roughly half of the lookups miss once warm
+constexpr size_t OPS_PER_THREAD = 1 << 20;
+
+struct Key
+{
+  uint32_t a;
+  uint32_t b;
+
+  bool operator==(const Key &other) const { return a == other.a && b == other.b; }
+};
+
+struct KeyHash
+{
+  size_t operator()(const Key &key) const { return (static_cast<size_t>(key.a) << 32) | key.b; }
+};
+
+uint64_t compute(const Key &key)
+{
+  uint64_t ret = key.a;
+  for(unsigned i = 0; i < 16; ++i)
+    ret = ret * 6364136223846793005ull + key.b;
+
+  return ret;
+}
+
+Key key_at(bench::Rng &rng)
+{
+  const auto k = static_cast<uint32_t>(rng.next() % KEY_RANGE);
+  return Key{k, k ^ 0x5bd1e995u};
+}
+
+// std::unordered_map with a mutex, trimmed back to capacity by dropping everything when full
+struct LockedMap
+{
+  std::mutex mutex;
+  std::unordered_map<Key, uint64_t, KeyHash> map;
+
+  uint64_t get_or_compute(const Key &key)
+  {
+    {
+      std::lock_guard<std::mutex> lock{mutex};
+      const auto it = map.find(key);
+      if(it != map.end())
+        return it->second;
+    }
+
+    const uint64_t value = compute(key);
+
+    std::lock_guard<std::mutex> lock{mutex};
+    if(map.size() >= CAPACITY)
+      map.clear();
+
+    map.emplace(key, value);
+    return value;
+  }
+};
+
+template<typename Op>
+double mops(unsigned threads, Op op)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> workers;
+  for(unsigned t = 0; t < threads; ++t)
+  {
+    workers.emplace_back([&op, t] {
+      bench::Rng rng{0x9E3779B97F4A7C15ull + t};
+      uint64_t sum = 0;
+      for(size_t i = 0; i < OPS_PER_THREAD; ++i)
+        sum += op(key_at(rng));
+      bench::do_not_optimize(sum);
+    });
+  }
+
+  for(auto &worker : workers)
+    worker.join();
+
+  const double us = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+  return static_cast<double>(threads * OPS_PER_THREAD) / us;
+}
+
+void report(const char *name, unsigned threads, double mopsPerSec)
+{
+  char label[96];
+  std::snprintf(label, sizeof(label), "%s, %u threads", name, threads);
+  std::printf("%-56s %12.3f Mops/s\n", label, mopsPerSec);
+}
+
+} // namespace
+
+int main()
+{
+  {
+    Memo<Key, uint64_t, KeyHash> memo{CAPACITY};
+    report("Memo get_or_compute", 1, mops(1, [&memo](const Key &key) { return memo.get_or_compute(key, compute); }));
+
+    const MemoStats &stats = memo.stats();
+    std::printf("  hits %llu, misses %llu, evictions %llu\n",
+        static_cast<unsigned long long>(stats.hits), static_cast<unsigned long long>(stats.misses), static_cast<unsigned long long>(stats.evictions));
+  }
+
+  {
+    std::unordered_map<Key, uint64_t, KeyHash> map;
+    report("unordered_map find/emplace, unbounded", 1, mops(1, [&map](const Key &key) {
+      const auto it = map.find(key);
+      if(it != map.end())
+        return it->second;
+
+      return map.emplace(key, compute(key)).first->second;
+    }));
+  }
+
+  for(const unsigned threads : {1u, 4u, 16u})
+  {
+    ShardedMemo<Key, uint64_t, KeyHash> memo{CAPACITY, 64};
+    report("ShardedMemo get_or_compute", threads, mops(threads, [&memo](const Key &key) { return memo.get_or_compute(key, compute); }));
+
+    LockedMap locked;
+    report("mutex + unordered_map", threads, mops(threads, [&locked](const Key &key) { return locked.get_or_compute(key); }));
+  }
+
+  return 0;
+}
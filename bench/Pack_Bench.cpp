@@ -0,0 +1,189 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <OptionalPack.hpp>
+
+#include "Bench.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+constexpr size_t COUNT = 1 << 16;
+
+// a request handler input, every field independently optional
+struct Request
+{
+  Optional<int32_t> user;
+  Optional<int32_t> session;
+  Optional<int32_t> token;
+  Optional<int32_t> locale;
+  Optional<int32_t> page;
+  Optional<int32_t> limit;
+  Optional<int32_t> sort;
+  Optional<int32_t> filter;
+};
+
+std::vector<Request> make_requests(unsigned percent)
+{
+  bench::Rng rng{percent};
+  std::vector<Request> requests(COUNT);
+  int32_t val = 0;
+  for(auto &req : requests)
+  {
+    for(auto *opt : {&req.user, &req.session, &req.token, &req.locale, &req.page, &req.limit, &req.sort, &req.filter})
+    {
+      if(rng.chance(percent))
+        *opt = ++val;
+    }
+  }
+
+  return requests;
+}
+
+int64_t combine(int32_t a, int32_t b, int32_t c, int32_t d)
+{
+  return static_cast<int64_t>(a) * 3 + b - c + (d >> 1);
+}
+
+// each field engaged 84%, so all four required ones are there about half the time
+void all_required()
+{
+  const auto requests = make_requests(84);
+
+  bench::report("4 required fields, nested ifs", bench::ns_per_op(1, [&](size_t) {
+    int64_t sum = 0;
+    for(const auto &req : requests)
+    {
+      if(req.user)
+      {
+        if(req.session)
+        {
+          if(req.token)
+          {
+            if(req.locale)
+              sum += combine(*req.user, *req.session, *req.token, *req.locale);
+          }
+        }
+      }
+    }
+    bench::do_not_optimize(sum);
+  }) / COUNT);
+
+  bench::report("4 required fields, optional_apply", bench::ns_per_op(1, [&](size_t) {
+    int64_t sum = 0;
+    for(const auto &req : requests)
+      sum += optional_apply(combine, req.user, req.session, req.token, req.locale).value_or(0);
+    bench::do_not_optimize(sum);
+  }) / COUNT);
+}
+
+// each field engaged 50%, eight equally likely combinations of three fields
+void dispatch()
+{
+  const auto requests = make_requests(50);
+
+  bench::report("3 fields, 8 cases, if chain", bench::ns_per_op(1, [&](size_t) {
+    int64_t sum = 0;
+    for(const auto &req : requests)
+    {
+      if(req.user && req.session && req.token)
+        sum += *req.user + *req.session + *req.token;
+      else if(req.user && req.session)
+        sum += *req.user - *req.session;
+      else if(req.user && req.token)
+        sum += *req.user ^ *req.token;
+      else if(req.session && req.token)
+        sum += *req.session * 3 + *req.token;
+      else if(req.user)
+        sum += *req.user;
+      else if(req.session)
+        sum += *req.session >> 1;
+      else if(req.token)
+        sum -= *req.token;
+      else
+        sum += 1;
+    }
+    bench::do_not_optimize(sum);
+  }) / COUNT);
+
+  bench::report("3 fields, 8 cases, switch on optional_mask", bench::ns_per_op(1, [&](size_t) {
+    int64_t sum = 0;
+    for(const auto &req : requests)
+    {
+      switch(optional_mask(req.user, req.session, req.token))
+      {
+        case 0x7: sum += *req.user + *req.session + *req.token; break;
+        case 0x3: sum += *req.user - *req.session; break;
+        case 0x5: sum += *req.user ^ *req.token; break;
+        case 0x6: sum += *req.session * 3 + *req.token; break;
+        case 0x1: sum += *req.user; break;
+        case 0x2: sum += *req.session >> 1; break;
+        case 0x4: sum -= *req.token; break;
+        default: sum += 1; break;
+      }
+    }
+    bench::do_not_optimize(sum);
+  }) / COUNT);
+}
+
+// each field engaged 8%, any of the eight present about half the time
+void any_present()
+{
+  const auto requests = make_requests(8);
+
+  bench::report("any of 8 fields, || chain", bench::ns_per_op(1, [&](size_t) {
+    size_t count = 0;
+    for(const auto &req : requests)
+    {
+      if(req.user || req.session || req.token || req.locale || req.page || req.limit || req.sort || req.filter)
+        ++count;
+    }
+    bench::do_not_optimize(count);
+  }) / COUNT);
+
+  bench::report("any of 8 fields, optional_any", bench::ns_per_op(1, [&](size_t) {
+    size_t count = 0;
+    for(const auto &req : requests)
+    {
+      if(optional_any(req.user, req.session, req.token, req.locale, req.page, req.limit, req.sort, req.filter))
+        ++count;
+    }
+    bench::do_not_optimize(count);
+  }) / COUNT);
+}
+
+} // namespace
+
+int main()
+{
+  std::printf("ns per request, %zu requests, engagement pseudo random\n", COUNT);
+
+  all_required();
+  dispatch();
+  any_present();
+
+  return 0;
+}
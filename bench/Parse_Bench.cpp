@@ -0,0 +1,159 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <OptionalParse.hpp>
+
+#include "Bench.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t FIELDS = 1 << 16;
+
+std::vector<std::string> make_fields(bool floats, unsigned invalidPercent)
+{
+  bench::Rng rng{invalidPercent + (floats ? 100u : 0u)};
+  std::vector<std::string> ret(FIELDS);
+
+  char buffer[64];
+  for(auto &field : ret)
+  {
+    if(rng.chance(invalidPercent))
+      field = rng.chance(50) ? "" : "n/a";
+    else if(floats)
+    {
+      std::snprintf(buffer, sizeof(buffer), "%.*f", static_cast<int>(rng.next() % 6), static_cast<double>(rng.next() % 10000000) / 100.0);
+      field = buffer;
+    }
+    else
+    {
+      std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(rng.next() >> (rng.next() % 60)) - 1000);
+      field = buffer;
+    }
+  }
+
+  return ret;
+}
+
+void run_int(unsigned invalidPercent)
+{
+  const auto fields = make_fields(false, invalidPercent);
+  char name[96];
+
+  std::snprintf(name, sizeof(name), "int64   %3u%% invalid  parse<int64_t>", invalidPercent);
+  bench::report(name, bench::ns_per_op(FIELDS, [&](size_t i) {
+    const auto res = parse<int64_t>(fields[i].data(), fields[i].data() + fields[i].size());
+    bench::do_not_optimize(res);
+  }));
+
+  std::snprintf(name, sizeof(name), "int64   %3u%% invalid  strtoll + errno", invalidPercent);
+  bench::report(name, bench::ns_per_op(FIELDS, [&](size_t i) {
+    errno = 0;
+    char *end = nullptr;
+    const long long val = std::strtoll(fields[i].c_str(), &end, 10);
+    const bool ok = !fields[i].empty() && *end == '\0' && errno == 0;
+    bench::do_not_optimize(ok ? Optional<int64_t>(val) : Optional<int64_t>());
+  }));
+
+  std::snprintf(name, sizeof(name), "int64   %3u%% invalid  std::stoll + catch", invalidPercent);
+  bench::report(name, bench::ns_per_op(FIELDS, [&](size_t i) {
+    Optional<int64_t> res;
+    try
+    {
+      res = static_cast<int64_t>(std::stoll(fields[i]));
+    }
+    catch(const std::exception&)
+    {
+    }
+    bench::do_not_optimize(res);
+  }));
+}
+
+void run_double(unsigned invalidPercent)
+{
+  const auto fields = make_fields(true, invalidPercent);
+  char name[96];
+
+  std::snprintf(name, sizeof(name), "double  %3u%% invalid  parse<double>", invalidPercent);
+  bench::report(name, bench::ns_per_op(FIELDS, [&](size_t i) {
+    const auto res = parse<double>(fields[i].data(), fields[i].data() + fields[i].size());
+    bench::do_not_optimize(res);
+  }));
+
+  std::snprintf(name, sizeof(name), "double  %3u%% invalid  strtod + errno", invalidPercent);
+  bench::report(name, bench::ns_per_op(FIELDS, [&](size_t i) {
+    errno = 0;
+    char *end = nullptr;
+    const double val = std::strtod(fields[i].c_str(), &end);
+    const bool ok = !fields[i].empty() && *end == '\0' && errno == 0;
+    bench::do_not_optimize(ok ? Optional<double>(val) : Optional<double>());
+  }));
+
+  std::snprintf(name, sizeof(name), "double  %3u%% invalid  std::stod + catch", invalidPercent);
+  bench::report(name, bench::ns_per_op(FIELDS, [&](size_t i) {
+    Optional<double> res;
+    try
+    {
+      res = std::stod(fields[i]);
+    }
+    catch(const std::exception&)
+    {
+    }
+    bench::do_not_optimize(res);
+  }));
+}
+
+} // namespace
+
+int main()
+{
+  std::printf("ns per field\n");
+
+  for(const unsigned invalidPercent : {0u, 10u, 50u})
+  {
+    run_int(invalidPercent);
+    run_double(invalidPercent);
+  }
+
+  const auto fields = make_fields(false, 10);
+  std::string line;
+  for(const auto &field : fields)
+    line += field + ',';
+  line.pop_back();
+
+  bench::report("int64    10% invalid  parse_fields, per field", bench::ns_per_op(1, [&](size_t) {
+    OptionalArray<int64_t> column;
+    column.reserve(FIELDS);
+    bench::do_not_optimize(parse_fields(line.data(), line.data() + line.size(), ',', column));
+  }) / FIELDS);
+
+  return 0;
+}
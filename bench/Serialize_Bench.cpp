@@ -0,0 +1,132 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <OptionalSerialize.hpp>
+
+#include "Bench.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr size_t COUNT = 1 << 22;
+
+// flag byte plus payload per element, the baseline the block format replaces
+struct NaiveSink
+{
+  unsigned char *pos;
+
+  template<typename T>
+  void write(const Optional<T> &opt)
+  {
+    *pos++ = opt.has_value() ? 1 : 0;
+    if(opt)
+    {
+      std::memcpy(pos, &*opt, sizeof(T));
+      pos += sizeof(T);
+    }
+  }
+};
+
+// writes into preallocated memory so the sink cost stays out of the picture
+struct RawSink
+{
+  unsigned char *pos;
+
+  void write(const void *data, size_t size)
+  {
+    std::memcpy(pos, data, size);
+    pos += size;
+  }
+};
+
+template<typename T>
+void run(const char *typeName, unsigned engagedPercent)
+{
+  bench::Rng rng;
+  std::vector<Optional<T>> column(COUNT);
+  size_t engaged = 0;
+  for(auto &opt : column)
+  {
+    if(rng.chance(engagedPercent))
+    {
+      opt = static_cast<T>(rng.next());
+      ++engaged;
+    }
+  }
+
+  std::vector<unsigned char> out(COUNT * (sizeof(T) + 1) + 4096);
+  const double inputBytes = static_cast<double>(COUNT * sizeof(Optional<T>));
+  char name[96];
+
+  std::snprintf(name, sizeof(name), "%s %u%% engaged, per element write", typeName, engagedPercent);
+  const double naiveNs = bench::ns_per_op(1, [&](size_t) {
+    NaiveSink sink{out.data()};
+    for(const auto &opt : column)
+      sink.write(opt);
+    bench::do_not_optimize(sink.pos);
+  });
+  bench::report_throughput(name, inputBytes, naiveNs);
+
+  size_t written = 0;
+  std::snprintf(name, sizeof(name), "%s %u%% engaged, block write", typeName, engagedPercent);
+  const double blockNs = bench::ns_per_op(1, [&](size_t) {
+    RawSink sink{out.data()};
+    OptionalWriter<RawSink> writer{sink};
+    writer.write(column);
+    written = static_cast<size_t>(writer.offset());
+    bench::do_not_optimize(sink.pos);
+  });
+  bench::report_throughput(name, inputBytes, blockNs);
+
+  std::vector<Optional<T>> back;
+  back.reserve(COUNT);
+  std::snprintf(name, sizeof(name), "%s %u%% engaged, block read", typeName, engagedPercent);
+  const double readNs = bench::ns_per_op(1, [&](size_t) {
+    back.clear();
+    OptionalBufferSource source{out.data(), written};
+    OptionalReader<OptionalBufferSource> reader{source};
+    reader.read(back);
+    bench::do_not_optimize(back.data());
+  });
+  bench::report_throughput(name, inputBytes, readNs);
+
+  std::printf("%-56s %12zu bytes, per element format %zu bytes\n", "  block size", written, COUNT + engaged * sizeof(T));
+}
+
+} // namespace
+
+int main()
+{
+  for(const unsigned percent : {10u, 50u, 90u})
+  {
+    run<int64_t>("int64_t", percent);
+    run<int32_t>("int32_t", percent);
+    run<double>("double", percent);
+  }
+
+  return 0;
+}
@@ -0,0 +1,164 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <SharedOptional.hpp>
+
+#include "Bench.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t READS_PER_THREAD = 1 << 18;
+constexpr unsigned THREAD_COUNTS[] = {1, 2, 4, 8, 16, 32, 64};
+
+struct Config
+{
+  int64_t timeoutMs;
+  int64_t retries;
+  int64_t payload[6];
+};
+
+struct SharedPolicy
+{
+  SharedOptional<Config> config{Config{100, 3, {}}};
+
+  int64_t read()
+  {
+    const auto guard = config.read();
+    return guard ? guard->timeoutMs + guard->retries : 0;
+  }
+
+  void write(int64_t i) { config.store(Config{i, 3, {}}); }
+};
+
+struct SharedMutexPolicy
+{
+  std::shared_mutex mutex;
+  Optional<Config> config{Config{100, 3, {}}};
+
+  int64_t read()
+  {
+    std::shared_lock<std::shared_mutex> lock{mutex};
+    return config ? config->timeoutMs + config->retries : 0;
+  }
+
+  void write(int64_t i)
+  {
+    std::unique_lock<std::shared_mutex> lock{mutex};
+    config = Config{i, 3, {}};
+  }
+};
+
+struct MutexPolicy
+{
+  std::mutex mutex;
+  Optional<Config> config{Config{100, 3, {}}};
+
+  int64_t read()
+  {
+    std::lock_guard<std::mutex> lock{mutex};
+    return config ? config->timeoutMs + config->retries : 0;
+  }
+
+  void write(int64_t i)
+  {
+    std::lock_guard<std::mutex> lock{mutex};
+    config = Config{i, 3, {}};
+  }
+};
+
+// wall clock ns per read over all readers, with one writer publishing every millisecond
+template<typename Policy>
+double run(unsigned threads)
+{
+  Policy policy;
+  std::atomic<bool> go{false};
+  std::atomic<unsigned> readersLeft{threads};
+
+  std::vector<std::thread> readers;
+  for(unsigned t = 0; t < threads; ++t)
+  {
+    readers.emplace_back([&] {
+      while(!go.load(std::memory_order_acquire))
+        std::this_thread::yield();
+
+      int64_t sum = 0;
+      for(size_t i = 0; i < READS_PER_THREAD; ++i)
+        sum += policy.read();
+      bench::do_not_optimize(sum);
+      --readersLeft;
+    });
+  }
+
+  std::thread writer([&] {
+    while(!go.load(std::memory_order_acquire))
+      std::this_thread::yield();
+
+    for(int64_t i = 0; readersLeft.load(std::memory_order_acquire) != 0; ++i)
+    {
+      policy.write(i);
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+
+  const auto start = std::chrono::steady_clock::now();
+  go.store(true, std::memory_order_release);
+  for(auto &r : readers)
+    r.join();
+  const auto end = std::chrono::steady_clock::now();
+  writer.join();
+
+  const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+  return ns / static_cast<double>(READS_PER_THREAD * threads);
+}
+
+} // namespace
+
+int main()
+{
+  std::printf("wall clock ns per read, %zu reads per thread, one writer every 1ms, %u hardware threads\n",
+      READS_PER_THREAD, std::thread::hardware_concurrency());
+
+  char name[96];
+  for(const unsigned threads : THREAD_COUNTS)
+  {
+    std::snprintf(name, sizeof(name), "%2u readers  SharedOptional", threads);
+    bench::report(name, run<SharedPolicy>(threads));
+
+    std::snprintf(name, sizeof(name), "%2u readers  shared_mutex + Optional", threads);
+    bench::report(name, run<SharedMutexPolicy>(threads));
+
+    std::snprintf(name, sizeof(name), "%2u readers  mutex + Optional", threads);
+    bench::report(name, run<MutexPolicy>(threads));
+  }
+
+  return 0;
+}
@@ -0,0 +1,118 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <SlotPool.hpp>
+
+#include "Bench.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr size_t LIVE = 1 << 18;
+constexpr size_t OPS = 1 << 20;
+
+struct Entity
+{
+  int64_t id;
+  double pos[3];
+  uint32_t flags;
+};
+
+using Map = std::unordered_map<uint64_t, std::unique_ptr<Entity>>;
+
+} // namespace
+
+int main()
+{
+  bench::Rng rng;
+  std::printf("%zu live objects\n", LIVE);
+
+  // fill
+  SlotPool<Entity> pool;
+  std::vector<SlotHandle> handles(LIVE);
+  bench::report("insert      SlotPool", bench::ns_per_op(1, [&](size_t) {
+    pool.clear();
+    for(size_t i = 0; i < LIVE; ++i)
+      handles[i] = pool.insert(Entity{static_cast<int64_t>(i), {0.0, 0.0, 0.0}, 0});
+  }) / LIVE);
+
+  Map map;
+  uint64_t nextId = 0;
+  std::vector<uint64_t> ids(LIVE);
+  bench::report("insert      unordered_map<id, unique_ptr>", bench::ns_per_op(1, [&](size_t) {
+    map.clear();
+    for(size_t i = 0; i < LIVE; ++i)
+    {
+      ids[i] = nextId++;
+      map.emplace(ids[i], std::unique_ptr<Entity>(new Entity{static_cast<int64_t>(i), {0.0, 0.0, 0.0}, 0}));
+    }
+  }) / LIVE);
+
+  // lookups, a quarter of them stale
+  std::vector<size_t> picks(OPS);
+  for(auto &p : picks)
+    p = rng.next() % LIVE;
+
+  std::vector<SlotHandle> staleHandles(handles);
+  std::vector<uint64_t> staleIds(ids);
+  for(size_t i = 0; i < LIVE; i += 4)
+  {
+    pool.erase(handles[i]);
+    handles[i] = pool.insert(Entity{static_cast<int64_t>(i), {0.0, 0.0, 0.0}, 0});
+
+    map.erase(ids[i]);
+    ids[i] = nextId++;
+    map.emplace(ids[i], std::unique_ptr<Entity>(new Entity{static_cast<int64_t>(i), {0.0, 0.0, 0.0}, 0}));
+  }
+
+  bench::report("get         SlotPool (25% stale)", bench::ns_per_op(OPS, [&](size_t i) {
+    const auto ent = pool.get(staleHandles[picks[i]]);
+    bench::do_not_optimize(ent ? ent->id : -1);
+  }));
+
+  bench::report("get         unordered_map (25% stale)", bench::ns_per_op(OPS, [&](size_t i) {
+    const auto it = map.find(staleIds[picks[i]]);
+    bench::do_not_optimize(it != map.end() ? it->second->id : -1);
+  }));
+
+  // churn: erase one, insert one
+  bench::report("erase+insert SlotPool", bench::ns_per_op(OPS, [&](size_t i) {
+    const size_t p = picks[i];
+    pool.erase(handles[p]);
+    handles[p] = pool.insert(Entity{static_cast<int64_t>(p), {0.0, 0.0, 0.0}, 0});
+  }));
+
+  bench::report("erase+insert unordered_map", bench::ns_per_op(OPS, [&](size_t i) {
+    const size_t p = picks[i];
+    map.erase(ids[p]);
+    ids[p] = nextId++;
+    map.emplace(ids[p], std::unique_ptr<Entity>(new Entity{static_cast<int64_t>(p), {0.0, 0.0, 0.0}, 0}));
+  }));
+
+  return 0;
+}
@@ -0,0 +1,89 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <OptionalSlot.hpp>
+
+#include "Bench.hpp"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t UPDATES = 1 << 22;
+
+struct Stats
+{
+  uint64_t count;
+  uint64_t sum;
+};
+
+// every worker bumps its own slot, the stores have to reach memory each time
+template<typename Slots>
+double run(Slots &slots, unsigned workers)
+{
+  return bench::ns_per_op(1, [&](size_t) {
+    std::vector<std::thread> threads;
+    for(unsigned w = 0; w < workers; ++w)
+    {
+      threads.emplace_back([&slots, w] {
+        auto &slot = slots[w];
+        for(size_t i = 0; i < UPDATES; ++i)
+        {
+          slot->count++;
+          slot->sum += i;
+          bench::clobber();
+        }
+      });
+    }
+
+    for(auto &t : threads)
+      t.join();
+  }, 3) / static_cast<double>(UPDATES * workers);
+}
+
+} // namespace
+
+int main()
+{
+  std::printf("ns per update, %u hardware threads\n", std::thread::hardware_concurrency());
+
+  for(const unsigned workers : {1u, 2u, 4u, 8u})
+  {
+    std::vector<Optional<Stats>> packed(workers, Optional<Stats>(Stats{0, 0}));
+    OptionalSlotArray<Stats> padded(workers);
+    for(unsigned w = 0; w < workers; ++w)
+      padded[w] = Stats{0, 0};
+
+    char name[96];
+    std::snprintf(name, sizeof(name), "%u workers  vector<Optional<Stats>>", workers);
+    bench::report(name, run(packed, workers));
+
+    std::snprintf(name, sizeof(name), "%u workers  OptionalSlotArray<Stats>", workers);
+    bench::report(name, run(padded, workers));
+  }
+
+  return 0;
+}
@@ -0,0 +1,78 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <SmallOptionalVector.hpp>
+
+#include "Bench.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t RECORDS = 1 << 18;
+
+// a record with 0-4 repeated optional entries, built and consumed
+template<typename Vec, typename T, typename Make>
+double run(const std::vector<unsigned> &entries, Make &&make)
+{
+  return bench::ns_per_op(RECORDS, [&](size_t i) {
+    Vec vec;
+    for(unsigned e = 0; e < entries[i]; ++e)
+    {
+      if(e % 3 == 1)
+        vec.push_back(Optional<T>());
+      else
+        vec.push_back(Optional<T>(make(e)));
+    }
+
+    size_t engaged = 0;
+    for(const auto &opt : vec)
+      engaged += opt.has_value();
+    bench::do_not_optimize(engaged);
+  });
+}
+
+} // namespace
+
+int main()
+{
+  bench::Rng rng;
+  std::vector<unsigned> entries(RECORDS);
+  for(auto &e : entries)
+    e = static_cast<unsigned>(rng.next() % 5);
+
+  std::printf("ns per record, 0-4 entries each\n");
+
+  const auto makeInt = [](unsigned e) { return static_cast<int64_t>(e); };
+  bench::report("int64   std::vector<Optional<T>>", run<std::vector<Optional<int64_t>>, int64_t>(entries, makeInt));
+  bench::report("int64   SmallOptionalVector<T, 4>", run<SmallOptionalVector<int64_t, 4>, int64_t>(entries, makeInt));
+
+  const auto makeStr = [](unsigned e) { return std::string(1 + e, 'x'); };
+  bench::report("string  std::vector<Optional<T>>", run<std::vector<Optional<std::string>>, std::string>(entries, makeStr));
+  bench::report("string  SmallOptionalVector<T, 4>", run<SmallOptionalVector<std::string, 4>, std::string>(entries, makeStr));
+
+  return 0;
+}
@@ -45,7 +45,9 @@ enum class Event
 {
   DefaultCtor,
   CopyCtor,
-  MoveCtor
+  MoveCtor,
+  CopyAssign,
+  MoveAssign
 };
 
 struct Observe
@@ -65,6 +67,18 @@ struct Observe
     : event{Event::MoveCtor}, placeholder{0}
   {}
 
+  Observe& operator=(const Observe&)
+  {
+    event = Event::CopyAssign;
+    return *this;
+  }
+
+  Observe& operator=(Observe&&)
+  {
+    event = Event::MoveAssign;
+    return *this;
+  }
+
 };
 
 struct DtorCalled
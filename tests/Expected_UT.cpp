@@ -0,0 +1,361 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <Expected.hpp>
+
+#include "Common.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace {
+
+enum class Errc : uint8_t
+{
+  Empty,
+  Invalid,
+  Range
+};
+
+Expected<int, Errc> parse_digit(char c)
+{
+  if(c == '\0')
+    return make_unexpected(Errc::Empty);
+
+  if(c < '0' || c > '9')
+    return make_unexpected(Errc::Invalid);
+
+  return c - '0';
+}
+
+Expected<int, Errc> below_five(int v)
+{
+  if(v >= 5)
+    return make_unexpected(Errc::Range);
+
+  return v;
+}
+
+struct CopyFailure {};
+
+// copies throw while 'fail' is set, the string makes a double destroy visible to the sanitizers
+template<bool NoexceptMove>
+struct ThrowingCopy
+{
+  static bool fail;
+
+  std::string str;
+
+  static std::string&& take(std::string &s)
+  {
+    if(!NoexceptMove && fail)
+      throw CopyFailure{};
+
+    return std::move(s);
+  }
+
+  explicit ThrowingCopy(const char *s) : str(s) {}
+
+  ThrowingCopy(const ThrowingCopy &other)
+    : str(other.str)
+  {
+    if(fail)
+      throw CopyFailure{};
+  }
+
+  // a throwing move throws before it takes anything from the source
+  ThrowingCopy(ThrowingCopy &&other) noexcept(NoexceptMove)
+    : str(take(other.str))
+  {}
+
+  ThrowingCopy& operator=(const ThrowingCopy&) = default;
+  ThrowingCopy& operator=(ThrowingCopy&&) = default;
+};
+
+template<bool NoexceptMove>
+bool ThrowingCopy<NoexceptMove>::fail = false;
+
+} // namespace
+
+TEST(Expected, size)
+{
+  static_assert(sizeof(Expected<int32_t, Errc>) == sizeof(int32_t) * 2, "");
+  static_assert(sizeof(Expected<uint8_t, Errc>) == 2, "");
+  static_assert(sizeof(Expected<double, int32_t>) == sizeof(double) * 2, "");
+  static_assert(sizeof(Expected<int32_t, double>) == sizeof(double) * 2, "");
+  static_assert(sizeof(Expected<std::string, Errc>) == sizeof(Optional<std::string>), "");
+}
+
+TEST(Expected, trivialDtorPropagation)
+{
+  static_assert(std::is_trivially_destructible<Expected<int, Errc>>::value, "");
+  static_assert(std::is_trivially_destructible<Expected<double, int>>::value, "");
+  static_assert(!std::is_trivially_destructible<Expected<std::string, Errc>>::value, "");
+  static_assert(!std::is_trivially_destructible<Expected<int, std::string>>::value, "");
+}
+
+TEST(Expected, valueAndError)
+{
+  const auto ok = parse_digit('7');
+  ASSERT_TRUE(ok);
+  EXPECT_TRUE(ok.has_value());
+  EXPECT_EQ(7, *ok);
+  EXPECT_EQ(7, ok.value());
+  EXPECT_EQ(7, ok.value_or(-1));
+
+  const auto err = parse_digit('x');
+  ASSERT_FALSE(err);
+  EXPECT_EQ(Errc::Invalid, err.error());
+  EXPECT_EQ(-1, err.value_or(-1));
+
+  const Expected<int, Errc> defaulted;
+  ASSERT_TRUE(defaulted);
+  EXPECT_EQ(0, *defaulted);
+}
+
+TEST(Expected, sameValueAndErrorType)
+{
+  const Expected<int, int> ok(3);
+  const Expected<int, int> err(make_unexpected(4));
+
+  ASSERT_TRUE(ok);
+  EXPECT_EQ(3, *ok);
+  ASSERT_FALSE(err);
+  EXPECT_EQ(4, err.error());
+}
+
+TEST(Expected, copyAndMove)
+{
+  Expected<std::string, std::string> ok(std::string("value"));
+  Expected<std::string, std::string> err(make_unexpected(std::string("error")));
+
+  auto okCopy = ok;
+  auto errCopy = err;
+  EXPECT_EQ("value", *okCopy);
+  EXPECT_EQ("error", errCopy.error());
+
+  auto okMoved = std::move(okCopy);
+  auto errMoved = std::move(errCopy);
+  EXPECT_EQ("value", *okMoved);
+  EXPECT_EQ("error", errMoved.error());
+
+  okMoved = err;
+  ASSERT_FALSE(okMoved);
+  EXPECT_EQ("error", okMoved.error());
+
+  errMoved = std::move(ok);
+  ASSERT_TRUE(errMoved);
+  EXPECT_EQ("value", *errMoved);
+
+  errMoved = Expected<std::string, std::string>(std::string("other"));
+  EXPECT_EQ("other", *errMoved);
+}
+
+TEST(Expected, moveOnlyValue)
+{
+  Expected<std::unique_ptr<int>, Errc> ptr(std::unique_ptr<int>(new int(5)));
+  auto moved = std::move(ptr);
+  ASSERT_TRUE(moved);
+  EXPECT_EQ(5, **moved);
+
+  const auto doubled = std::move(moved).transform([](std::unique_ptr<int> &&p) { return *p * 2; });
+  EXPECT_EQ(10, *doubled);
+}
+
+TEST(Expected, dtorCalledOnce)
+{
+  unsigned dtorCalled = 0;
+  {
+    Expected<util::DtorCalled, Errc> ok(util::DtorCalled{dtorCalled});
+    dtorCalled = 0;
+  }
+  EXPECT_EQ(1u, dtorCalled);
+
+  dtorCalled = 0;
+  {
+    Expected<int, util::DtorCalled> err(make_unexpected(util::DtorCalled{dtorCalled}));
+    dtorCalled = 0;
+    const auto copy = err;
+    EXPECT_EQ(0u, dtorCalled);
+  }
+  EXPECT_EQ(2u, dtorCalled);
+
+  dtorCalled = 0;
+  {
+    const Expected<int, util::DtorCalled> ok(1);
+  }
+  EXPECT_EQ(0u, dtorCalled);
+}
+
+TEST(Expected, observeAssignment)
+{
+  Expected<util::Observe, Errc> lhs;
+  const Expected<util::Observe, Errc> rhs;
+
+  lhs = rhs;
+  EXPECT_EQ(util::Event::CopyAssign, lhs->event);
+
+  lhs = Expected<util::Observe, Errc>();
+  EXPECT_EQ(util::Event::MoveAssign, lhs->event);
+
+  Expected<util::Observe, Errc> err(make_unexpected(Errc::Empty));
+  err = rhs;
+  EXPECT_EQ(util::Event::CopyCtor, err->event);
+}
+
+TEST(Expected, monadic)
+{
+  const auto chained = parse_digit('3').and_then(below_five).transform([](int v) { return v * 10; });
+  ASSERT_TRUE(chained);
+  EXPECT_EQ(30, *chained);
+
+  const auto outOfRange = parse_digit('8').and_then(below_five).transform([](int v) { return v * 10; });
+  ASSERT_FALSE(outOfRange);
+  EXPECT_EQ(Errc::Range, outOfRange.error());
+
+  const auto firstError = parse_digit('?').and_then(below_five);
+  ASSERT_FALSE(firstError);
+  EXPECT_EQ(Errc::Invalid, firstError.error());
+
+  const auto described = parse_digit('\0').transform_error([](Errc e) { return e == Errc::Empty ? std::string("empty") : std::string("other"); });
+  static_assert(std::is_same<decltype(described), const Expected<int, std::string>>::value, "");
+  ASSERT_FALSE(described);
+  EXPECT_EQ("empty", described.error());
+
+  const auto recovered = parse_digit('x').or_else([](Errc) { return Expected<int, Errc>(0); });
+  ASSERT_TRUE(recovered);
+  EXPECT_EQ(0, *recovered);
+
+  const auto untouched = parse_digit('4').or_else([](Errc) { return Expected<int, Errc>(0); });
+  EXPECT_EQ(4, *untouched);
+}
+
+TEST(Expected, optionalConversions)
+{
+  const Optional<int> some(5);
+  const Optional<int> none;
+
+  const auto fromSome = to_expected(some, Errc::Empty);
+  ASSERT_TRUE(fromSome);
+  EXPECT_EQ(5, *fromSome);
+
+  const auto fromNone = to_expected(none, Errc::Empty);
+  ASSERT_FALSE(fromNone);
+  EXPECT_EQ(Errc::Empty, fromNone.error());
+
+  const auto backSome = fromSome.to_optional();
+  ASSERT_TRUE(backSome);
+  EXPECT_EQ(5, *backSome);
+  EXPECT_FALSE(fromNone.to_optional());
+
+  auto moved = to_expected(Optional<std::string>(std::string("str")), 0);
+  const Optional<std::string> str = std::move(moved).to_optional();
+  EXPECT_EQ("str", *str);
+}
+
+TEST(Expected, swap)
+{
+  Expected<std::string, int> a(std::string("a"));
+  Expected<std::string, int> b(make_unexpected(2));
+
+  swap(a, b);
+  ASSERT_FALSE(a);
+  EXPECT_EQ(2, a.error());
+  ASSERT_TRUE(b);
+  EXPECT_EQ("a", *b);
+
+  Expected<std::string, int> c(std::string("c"));
+  swap(b, c);
+  EXPECT_EQ("c", *b);
+  EXPECT_EQ("a", *c);
+}
+
+TEST(Expected, throwingAssignmentKeepsTarget)
+{
+  using Nothrow = ThrowingCopy<true>;
+  using Throwing = ThrowingCopy<false>;
+
+  Expected<std::string, Nothrow> value(std::string("value"));
+  const Expected<std::string, Nothrow> nothrowError(make_unexpected(Nothrow("error")));
+  Nothrow::fail = true;
+  EXPECT_THROW(value = nothrowError, CopyFailure);
+  Nothrow::fail = false;
+  ASSERT_TRUE(value);
+  EXPECT_EQ("value", *value);
+
+  // no noexcept move to build through, the old value moves aside and comes back
+  Expected<std::string, Throwing> other(std::string("other"));
+  Expected<std::string, Throwing> throwingError(make_unexpected(Throwing("error")));
+  Throwing::fail = true;
+  EXPECT_THROW(other = throwingError, CopyFailure);
+  EXPECT_THROW(other = std::move(throwingError), CopyFailure);
+  Throwing::fail = false;
+  ASSERT_TRUE(other);
+  EXPECT_EQ("other", *other);
+
+  Expected<Throwing, std::string> error(make_unexpected(std::string("error")));
+  const Expected<Throwing, std::string> throwingValue(Throwing("value"));
+  Throwing::fail = true;
+  EXPECT_THROW(error = throwingValue, CopyFailure);
+  Throwing::fail = false;
+  ASSERT_FALSE(error);
+  EXPECT_EQ("error", error.error());
+
+  other = throwingError;
+  ASSERT_FALSE(other);
+  EXPECT_EQ("error", other.error().str);
+}
+
+TEST(Expected, throwingSwapKeepsBoth)
+{
+  using Throwing = ThrowingCopy<false>;
+
+  Expected<Throwing, std::string> value(Throwing("value"));
+  Expected<Throwing, std::string> error(make_unexpected(std::string("error")));
+  Throwing::fail = true;
+  EXPECT_THROW(swap(value, error), CopyFailure);
+  Throwing::fail = false;
+  ASSERT_TRUE(value);
+  EXPECT_EQ("value", value->str);
+  ASSERT_FALSE(error);
+  EXPECT_EQ("error", error.error());
+
+  Expected<std::string, Throwing> lhs(make_unexpected(Throwing("error")));
+  Expected<std::string, Throwing> rhs(std::string("value"));
+  Throwing::fail = true;
+  EXPECT_THROW(swap(lhs, rhs), CopyFailure);
+  Throwing::fail = false;
+  ASSERT_FALSE(lhs);
+  EXPECT_EQ("error", lhs.error().str);
+  ASSERT_TRUE(rhs);
+  EXPECT_EQ("value", *rhs);
+
+  swap(lhs, rhs);
+  EXPECT_EQ("value", *lhs);
+  EXPECT_EQ("error", rhs.error().str);
+}
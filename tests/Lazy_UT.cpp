@@ -0,0 +1,193 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <Lazy.hpp>
+
+#include "Common.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+int forty_two()
+{
+  return 42;
+}
+
+} // namespace
+
+TEST(Lazy_UT, computesOnFirstAccessOnly)
+{
+  unsigned calls = 0;
+  auto lazy = make_lazy([&calls] { ++calls; return std::string("payload"); });
+
+  EXPECT_FALSE(lazy.has_value());
+  EXPECT_FALSE(lazy.peek());
+  EXPECT_EQ(0u, calls);
+
+  EXPECT_EQ("payload", *lazy);
+  EXPECT_EQ(7u, lazy->size());
+  EXPECT_EQ("payload", lazy.value());
+
+  EXPECT_TRUE(lazy.has_value());
+  ASSERT_TRUE(lazy.peek());
+  EXPECT_EQ("payload", *lazy.peek());
+  EXPECT_EQ(1u, calls);
+}
+
+TEST(Lazy_UT, invalidateRecomputes)
+{
+  int source = 1;
+  auto lazy = make_lazy([&source] { return source * 10; });
+
+  EXPECT_EQ(10, *lazy);
+
+  source = 2;
+  EXPECT_EQ(10, *lazy);
+
+  lazy.invalidate();
+  EXPECT_FALSE(lazy.has_value());
+  EXPECT_EQ(20, *lazy);
+
+  source = 3;
+  lazy.reset();
+  EXPECT_EQ(30, *lazy);
+}
+
+TEST(Lazy_UT, functionPointerGenerator)
+{
+  Lazy<int> lazy{&forty_two};
+
+  EXPECT_EQ(42, *lazy);
+  EXPECT_EQ(sizeof(int(*)()) + sizeof(Optional<int>), sizeof(lazy));
+}
+
+TEST(Lazy_UT, statelessGeneratorTakesNoSpace)
+{
+  auto lazy = make_lazy([] { return 5; });
+  auto wide = make_lazy([] { return 5.0; });
+
+  EXPECT_EQ(sizeof(Optional<int>), sizeof(lazy));
+  EXPECT_EQ(sizeof(Optional<double>), sizeof(wide));
+  EXPECT_TRUE(std::is_trivially_destructible<decltype(lazy)>::value);
+  EXPECT_EQ(5, *lazy);
+}
+
+TEST(Lazy_UT, constLazyStatefulGenerator)
+{
+  const auto lazy = make_lazy([calls = 0]() mutable { return ++calls; });
+  const auto sync = make_sync_lazy([calls = 10]() mutable { return ++calls; });
+
+  EXPECT_EQ(1, *lazy);
+  EXPECT_EQ(11, *sync);
+  EXPECT_EQ(1, *lazy);
+
+  // empty but only callable as non-const, kept as a member rather than a base
+  const auto empty = make_lazy([]() mutable { return 3; });
+  EXPECT_EQ(3, *empty);
+}
+
+TEST(Lazy_UT, destroysPayload)
+{
+  unsigned dtorCalled = 0;
+
+  {
+    auto lazy = make_lazy([&dtorCalled] { return util::DtorCalled{dtorCalled}; });
+    EXPECT_FALSE(std::is_trivially_destructible<decltype(lazy)>::value);
+
+    *lazy;
+    const unsigned afterCompute = dtorCalled;
+
+    lazy.invalidate();
+    EXPECT_EQ(afterCompute + 1, dtorCalled);
+
+    lazy.invalidate();
+    EXPECT_EQ(afterCompute + 1, dtorCalled);
+
+    *lazy;
+    dtorCalled = 0;
+  }
+
+  EXPECT_EQ(1u, dtorCalled);
+}
+
+TEST(Lazy_UT, copyAndMoveKeepState)
+{
+  unsigned calls = 0;
+  auto lazy = make_lazy([&calls] { ++calls; return std::string("abc"); });
+
+  const auto notComputed = lazy;
+  EXPECT_FALSE(notComputed.has_value());
+
+  *lazy;
+  const auto copied = lazy;
+  ASSERT_TRUE(copied.has_value());
+  EXPECT_EQ("abc", *copied);
+
+  auto moved = std::move(lazy);
+  ASSERT_TRUE(moved.has_value());
+  EXPECT_EQ("abc", *moved);
+  EXPECT_EQ(1u, calls);
+}
+
+TEST(Lazy_UT, syncRunsGeneratorOnce)
+{
+  std::atomic<unsigned> calls{0};
+  auto lazy = make_sync_lazy([&calls] {
+    calls.fetch_add(1);
+    std::this_thread::yield();
+    return std::vector<int>(1000, 3);
+  });
+
+  std::atomic<unsigned> badReads{0};
+  std::vector<std::thread> threads;
+  for(unsigned t = 0; t < 8; ++t)
+  {
+    threads.emplace_back([&] {
+      for(unsigned i = 0; i < 1000; ++i)
+      {
+        if(lazy->size() != 1000 || (*lazy)[999] != 3)
+          badReads.fetch_add(1);
+      }
+    });
+  }
+
+  for(auto &thread : threads)
+    thread.join();
+
+  EXPECT_EQ(1u, calls.load());
+  EXPECT_EQ(0u, badReads.load());
+  EXPECT_TRUE(lazy.has_value());
+
+  lazy.invalidate();
+  EXPECT_FALSE(lazy.peek());
+  EXPECT_EQ(1000u, lazy->size());
+  EXPECT_EQ(2u, calls.load());
+}
@@ -0,0 +1,218 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <Memo.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Key
+{
+  int a;
+  int b;
+
+  bool operator==(const Key &other) const { return a == other.a && b == other.b; }
+};
+
+struct KeyHash
+{
+  size_t operator()(const Key &key) const { return static_cast<size_t>(key.a) * 31u + static_cast<size_t>(key.b); }
+};
+
+// every key lands in the same bucket
+struct ConstantHash
+{
+  size_t operator()(int) const { return 0; }
+};
+
+} // namespace
+
+TEST(Memo_UT, findAndCompute)
+{
+  Memo<Key, std::string, KeyHash> memo{64};
+
+  EXPECT_FALSE(memo.find(Key{1, 2}));
+
+  unsigned calls = 0;
+  const auto compute = [&calls](const Key &key) { ++calls; return std::to_string(key.a + key.b); };
+
+  EXPECT_EQ("3", memo.get_or_compute(Key{1, 2}, compute));
+  EXPECT_EQ("3", memo.get_or_compute(Key{1, 2}, compute));
+  EXPECT_EQ(1u, calls);
+
+  const Optional<std::string&> found = memo.find(Key{1, 2});
+  ASSERT_TRUE(found);
+  EXPECT_EQ("3", *found);
+
+  *found = "changed";
+  EXPECT_EQ("changed", *memo.find(Key{1, 2}));
+
+  EXPECT_EQ(1u, memo.size());
+  EXPECT_EQ(3u, memo.stats().hits);
+  EXPECT_EQ(2u, memo.stats().misses);
+  EXPECT_EQ(0u, memo.stats().evictions);
+}
+
+TEST(Memo_UT, insertEraseClear)
+{
+  Memo<int, int> memo{32};
+
+  memo.insert(1, 10);
+  memo.insert(2, 20);
+  memo.insert(1, 11);
+
+  EXPECT_EQ(2u, memo.size());
+  EXPECT_EQ(11, *memo.find(1));
+
+  EXPECT_TRUE(memo.erase(1));
+  EXPECT_FALSE(memo.erase(1));
+  EXPECT_FALSE(memo.find(1));
+  EXPECT_EQ(1u, memo.size());
+
+  memo.clear();
+  EXPECT_EQ(0u, memo.size());
+  EXPECT_FALSE(memo.find(2));
+}
+
+TEST(Memo_UT, boundedCapacity)
+{
+  Memo<int, int> memo{100};
+  EXPECT_GE(memo.capacity(), 100u);
+
+  for(int i = 0; i < 10000; ++i)
+    memo.insert(i, i * 2);
+
+  EXPECT_LE(memo.size(), memo.capacity());
+  EXPECT_EQ(10000u - memo.size(), memo.stats().evictions);
+
+  for(int i = 0; i < 10000; ++i)
+  {
+    const auto found = memo.find(i);
+    if(found)
+    {
+      EXPECT_EQ(i * 2, *found);
+    }
+  }
+}
+
+TEST(Memo_UT, clockGivesReferencedEntriesSecondChance)
+{
+  Memo<int, int, ConstantHash> memo{8};
+  ASSERT_EQ(8u, memo.capacity());
+
+  for(int i = 0; i < 8; ++i)
+    memo.insert(i, i);
+
+  // touch everything but 3, the next insertion has to evict 3
+  for(int i = 0; i < 8; ++i)
+  {
+    if(i != 3)
+      memo.find(i);
+  }
+
+  memo.insert(100, 100);
+
+  EXPECT_FALSE(memo.find(3));
+  for(int i = 0; i < 8; ++i)
+  {
+    if(i != 3)
+    {
+      EXPECT_TRUE(memo.find(i)) << i;
+    }
+  }
+  EXPECT_TRUE(memo.find(100));
+  EXPECT_EQ(1u, memo.stats().evictions);
+}
+
+TEST(Memo_UT, recursiveCompute)
+{
+  Memo<uint64_t, uint64_t> memo{256};
+
+  std::function<uint64_t(uint64_t)> fib = [&](uint64_t n) -> uint64_t {
+    if(n < 2)
+      return n;
+
+    return memo.get_or_compute(n - 1, fib) + memo.get_or_compute(n - 2, fib);
+  };
+
+  EXPECT_EQ(12586269025ull, memo.get_or_compute(50, fib));
+  EXPECT_EQ(51u, memo.size());
+}
+
+TEST(Memo_UT, shardedConcurrentUse)
+{
+  ShardedMemo<int, int> memo{1024, 8};
+
+  std::atomic<unsigned> wrong{0};
+  std::vector<std::thread> threads;
+  for(int t = 0; t < 8; ++t)
+  {
+    threads.emplace_back([&memo, &wrong, t] {
+      for(int i = 0; i < 20000; ++i)
+      {
+        const int key = (i * 7 + t) % 2048;
+        if(memo.get_or_compute(key, [](int k) { return k * 3; }) != key * 3)
+          wrong.fetch_add(1);
+
+        const auto found = memo.find(key);
+        if(found && *found != key * 3)
+          wrong.fetch_add(1);
+      }
+    });
+  }
+
+  for(auto &thread : threads)
+    thread.join();
+
+  EXPECT_EQ(0u, wrong.load());
+  EXPECT_LE(memo.size(), memo.capacity());
+
+  const MemoStats stats = memo.stats();
+  EXPECT_EQ(8u * 20000u * 2u, stats.hits + stats.misses);
+  EXPECT_GT(stats.evictions, 0u);
+}
+
+TEST(Memo_UT, shardedStridedKeysSpread)
+{
+  // keys sharing their low bits, shard and bucket have to come from the high bits of the hash
+  for(const size_t stride : {16u, 256u, 4096u})
+  {
+    ShardedMemo<size_t, size_t> memo{1024, 16};
+    for(size_t i = 0; i < 512; ++i)
+      memo.insert(i * stride, i);
+
+    size_t kept = 0;
+    for(size_t i = 0; i < 512; ++i)
+      kept += memo.find(i * stride).has_value();
+
+    EXPECT_GE(kept, 480u) << "stride " << stride;
+  }
+}
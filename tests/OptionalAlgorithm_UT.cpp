@@ -0,0 +1,241 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <OptionalAlgorithm.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Column
+{
+  std::vector<Optional<int64_t>> span;
+  OptionalArray<int64_t> array;
+};
+
+Column make_column(size_t count, unsigned engagedPercent)
+{
+  Column ret{std::vector<Optional<int64_t>>(count), OptionalArray<int64_t>(count)};
+
+  uint64_t state = 0x2545F4914F6CDD1Dull;
+  for(size_t i = 0; i < count; ++i)
+  {
+    state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+    if(state % 100 < engagedPercent)
+    {
+      const auto val = static_cast<int64_t>(state % 1000) - 500;
+      ret.span[i] = val;
+      ret.array.set(i, val);
+    }
+  }
+
+  return ret;
+}
+
+const size_t SIZES[] = {0, 1, 63, 64, 65, 1000, (1 << 14) - 1, 1 << 14, 100003};
+const unsigned PERCENTS[] = {0, 10, 50, 100};
+const unsigned THREADS[] = {1, 2, 3, 7};
+
+} // namespace
+
+TEST(OptionalAlgorithm_UT, countMatchesReference)
+{
+  for(const size_t count : SIZES)
+  {
+    for(const unsigned percent : PERCENTS)
+    {
+      const Column column = make_column(count, percent);
+
+      size_t expected = 0;
+      for(const auto &opt : column.span)
+        expected += opt.has_value();
+
+      EXPECT_EQ(expected, optional_count(column.span.data(), count));
+      EXPECT_EQ(expected, optional_count(column.array));
+
+      for(const unsigned threads : THREADS)
+      {
+        EXPECT_EQ(expected, optional_count(ParallelPolicy{threads}, column.span.data(), count));
+        EXPECT_EQ(expected, optional_count(ParallelPolicy{threads}, column.array));
+      }
+    }
+  }
+}
+
+TEST(OptionalAlgorithm_UT, reduceMatchesReference)
+{
+  for(const size_t count : SIZES)
+  {
+    for(const unsigned percent : PERCENTS)
+    {
+      const Column column = make_column(count, percent);
+
+      int64_t sum = 7;
+      int64_t squares = 0;
+      for(const auto &opt : column.span)
+      {
+        if(opt)
+        {
+          sum += *opt;
+          squares += *opt * *opt;
+        }
+      }
+
+      const auto square = [](int64_t v) { return v * v; };
+      const auto plus = [](int64_t a, int64_t b) { return a + b; };
+
+      EXPECT_EQ(sum, optional_reduce(column.span.data(), count, int64_t{7}));
+      EXPECT_EQ(sum, optional_reduce(column.array, int64_t{7}));
+      EXPECT_EQ(squares, optional_transform_reduce(column.span.data(), count, int64_t{0}, plus, square));
+      EXPECT_EQ(squares, optional_transform_reduce(column.array, int64_t{0}, plus, square));
+
+      for(const unsigned threads : THREADS)
+      {
+        const ParallelPolicy par{threads};
+        EXPECT_EQ(sum, optional_reduce(par, column.span.data(), count, int64_t{7}));
+        EXPECT_EQ(sum, optional_reduce(par, column.array, int64_t{7}));
+        EXPECT_EQ(squares, optional_transform_reduce(par, column.span.data(), count, int64_t{0}, plus, square));
+        EXPECT_EQ(squares, optional_transform_reduce(par, column.array, int64_t{0}, plus, square));
+      }
+    }
+  }
+}
+
+TEST(OptionalAlgorithm_UT, transformMatchesReference)
+{
+  for(const size_t count : SIZES)
+  {
+    const Column column = make_column(count, 50);
+    const auto describe = [](int64_t v) { return std::to_string(v); };
+
+    for(const unsigned threads : THREADS)
+    {
+      std::vector<Optional<std::string>> out(count, Optional<std::string>{std::string("stale")});
+      optional_transform(ParallelPolicy{threads}, column.span.data(), count, out.data(), describe);
+
+      OptionalArray<std::string> outArray;
+      optional_transform(ParallelPolicy{threads}, column.array, outArray, describe);
+      ASSERT_EQ(count, outArray.size());
+
+      for(size_t i = 0; i < count; ++i)
+      {
+        ASSERT_EQ(column.span[i].has_value(), out[i].has_value()) << i;
+        ASSERT_EQ(column.span[i].has_value(), outArray.has_value(i)) << i;
+        if(column.span[i])
+        {
+          EXPECT_EQ(std::to_string(*column.span[i]), *out[i]);
+          EXPECT_EQ(std::to_string(*column.span[i]), *outArray[i]);
+        }
+      }
+    }
+  }
+}
+
+TEST(OptionalAlgorithm_UT, compactMatchesReference)
+{
+  for(const size_t count : SIZES)
+  {
+    for(const unsigned percent : PERCENTS)
+    {
+      const Column column = make_column(count, percent);
+
+      std::vector<int64_t> expected;
+      for(const auto &opt : column.span)
+      {
+        if(opt)
+          expected.push_back(*opt);
+      }
+
+      EXPECT_EQ(expected, compact(column.span.data(), count));
+      EXPECT_EQ(expected, compact(column.array));
+
+      for(const unsigned threads : THREADS)
+      {
+        EXPECT_EQ(expected, compact(ParallelPolicy{threads}, column.span.data(), count));
+        EXPECT_EQ(expected, compact(ParallelPolicy{threads}, column.array));
+      }
+    }
+  }
+}
+
+TEST(OptionalAlgorithm_UT, chunkBoundariesOnOutputLines)
+{
+  struct Odd
+  {
+    int32_t vals[3];
+  };
+
+  static_assert(detail::span_chunk_align<Optional<int64_t>>() == 4, "");
+  static_assert(detail::span_chunk_align<Optional<Odd>>() == 4, "");
+  static_assert(detail::span_chunk_align<uint64_t>() == 8, "");
+
+  std::vector<Optional<int64_t>> storage(100003 + 8);
+  for(size_t shift = 0; shift < 4; ++shift)
+  {
+    const Optional<int64_t> *out = storage.data() + shift;
+    const size_t lead = detail::span_line_lead(out);
+    const size_t count = 100003;
+
+    std::vector<size_t> begins(7, count);
+    std::vector<size_t> ends(7, 0);
+    const size_t chunks = detail::for_each_chunk(ParallelPolicy{7}, count, detail::span_chunk_align<Optional<int64_t>>(),
+      [&](size_t begin, size_t end, size_t chunk) {
+        begins[chunk] = begin;
+        ends[chunk] = end;
+      }, lead);
+
+    ASSERT_LE(chunks, 7u);
+    EXPECT_EQ(0u, begins[0]);
+    EXPECT_EQ(count, ends[chunks - 1]);
+    for(size_t c = 1; c < chunks; ++c)
+    {
+      EXPECT_EQ(ends[c - 1], begins[c]);
+      EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(out + begins[c]) % detail::CACHE_LINE);
+    }
+  }
+}
+
+TEST(OptionalAlgorithm_UT, transformMisalignedOutput)
+{
+  const Column column = make_column(100003, 60);
+
+  std::vector<Optional<int64_t>> expected(column.span.size());
+  optional_transform(column.span.data(), column.span.size(), expected.data(), [](int64_t v) { return v * 3; });
+
+  std::vector<Optional<int64_t>> storage(column.span.size() + 1);
+  optional_transform(ParallelPolicy{5}, column.span.data(), column.span.size(), storage.data() + 1, [](int64_t v) { return v * 3; });
+
+  for(size_t i = 0; i < expected.size(); ++i)
+  {
+    ASSERT_EQ(expected[i].has_value(), storage[i + 1].has_value());
+    if(expected[i])
+    {
+      EXPECT_EQ(*expected[i], *storage[i + 1]);
+    }
+  }
+}
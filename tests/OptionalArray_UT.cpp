@@ -0,0 +1,82 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <OptionalArray.hpp>
+
+#include <string>
+
+TEST(OptionalArray_UT, setResetAndAccess)
+{
+  OptionalArray<int> arr(130);
+
+  EXPECT_EQ(130u, arr.size());
+  EXPECT_EQ(3u, arr.bitmap_size());
+  EXPECT_EQ(0u, arr.count());
+
+  arr.set(0, 1);
+  arr.set(64, 2);
+  arr.set(129, 3);
+
+  EXPECT_EQ(3u, arr.count());
+  EXPECT_TRUE(arr.has_value(64));
+  EXPECT_FALSE(arr.has_value(65));
+  ASSERT_TRUE(arr[129]);
+  EXPECT_EQ(3, *arr[129]);
+  EXPECT_FALSE(arr[128]);
+
+  arr.reset(64);
+  EXPECT_FALSE(arr[64]);
+  EXPECT_EQ(2u, arr.count());
+}
+
+TEST(OptionalArray_UT, pushBackAndResize)
+{
+  OptionalArray<std::string> arr;
+
+  arr.push_back(std::string("a"));
+  arr.push_back(Optional<std::string>{});
+  Optional<std::string> engaged{std::string("c")};
+  arr.push_back(engaged);
+
+  ASSERT_EQ(3u, arr.size());
+  EXPECT_EQ("a", *arr[0]);
+  EXPECT_FALSE(arr[1]);
+  EXPECT_EQ("c", *arr[2]);
+
+  arr.resize(100);
+  EXPECT_EQ(2u, arr.count());
+  EXPECT_FALSE(arr[99]);
+
+  arr.resize(1);
+  EXPECT_EQ(1u, arr.count());
+
+  arr.resize(3);
+  EXPECT_FALSE(arr[2]); // shrinking drops the engaged bits past the new size
+  EXPECT_EQ(1u, arr.count());
+
+  arr.clear();
+  EXPECT_TRUE(arr.empty());
+}
@@ -0,0 +1,228 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <OptionalBatch.hpp>
+
+#include "Common.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Big
+{
+  int64_t id;
+  char payload[120];
+};
+
+const size_t SIZES[] = {0, 1, 63, 64, 65, 200};
+
+template<typename T>
+class OptionalBatchTyped : public ::testing::Test {};
+
+using BatchTypes = ::testing::Types<int32_t, double, Big, std::string>;
+TYPED_TEST_SUITE(OptionalBatchTyped, BatchTypes, );
+
+template<typename T>
+T make_value(int v);
+
+template<> int32_t make_value<int32_t>(int v) { return v; }
+template<> double make_value<double>(int v) { return v * 0.5; }
+template<> Big make_value<Big>(int v) { return Big{v, {'b'}}; }
+template<> std::string make_value<std::string>(int v) { return std::string(static_cast<size_t>(20 + v % 5), 's'); }
+
+template<typename T>
+bool same_value(const T &lhs, const T &rhs) { return lhs == rhs; }
+
+template<>
+bool same_value<Big>(const Big &lhs, const Big &rhs) { return lhs.id == rhs.id && lhs.payload[0] == rhs.payload[0]; }
+
+} // namespace
+
+TYPED_TEST(OptionalBatchTyped, resetAll)
+{
+  using T = TypeParam;
+
+  for(const size_t size : SIZES)
+  {
+    std::vector<Optional<T>> opts(size);
+    for(size_t i = 0; i < size; i += 3)
+      opts[i] = make_value<T>(static_cast<int>(i));
+
+    reset_all(opts.data(), opts.size());
+    for(const auto &opt : opts)
+    {
+      EXPECT_FALSE(opt);
+    }
+
+    // still usable afterwards
+    if(size > 0)
+    {
+      opts[0] = make_value<T>(1);
+      EXPECT_TRUE(same_value(make_value<T>(1), *opts[0]));
+    }
+  }
+}
+
+TYPED_TEST(OptionalBatchTyped, fillEngaged)
+{
+  using T = TypeParam;
+
+  for(const size_t size : SIZES)
+  {
+    std::vector<Optional<T>> opts(size);
+    for(size_t i = 0; i < size; i += 2)
+      opts[i] = make_value<T>(static_cast<int>(i));
+
+    const T value = make_value<T>(7);
+    fill_engaged(opts.data(), opts.size(), value);
+    for(const auto &opt : opts)
+    {
+      ASSERT_TRUE(opt);
+      EXPECT_TRUE(same_value(value, *opt));
+    }
+  }
+}
+
+TYPED_TEST(OptionalBatchTyped, uninitializedDefault)
+{
+  using T = TypeParam;
+
+  for(const size_t size : SIZES)
+  {
+    std::unique_ptr<unsigned char[]> raw(new unsigned char[size * sizeof(Optional<T>) + alignof(Optional<T>)]);
+    void *ptr = raw.get();
+    size_t space = size * sizeof(Optional<T>) + alignof(Optional<T>);
+    auto *first = static_cast<Optional<T>*>(std::align(alignof(Optional<T>), size * sizeof(Optional<T>), ptr, space));
+    std::memset(static_cast<void*>(first), 0xAB, size * sizeof(Optional<T>));
+
+    uninitialized_default_n(first, size);
+    for(size_t i = 0; i < size; ++i)
+    {
+      EXPECT_FALSE(first[i]);
+    }
+
+    if(size > 0)
+    {
+      first[size - 1] = make_value<T>(3);
+      EXPECT_TRUE(first[size - 1]);
+    }
+
+    for(size_t i = 0; i < size; ++i)
+      first[i].~Optional<T>();
+  }
+}
+
+TEST(OptionalBatch, resetAllDtorCount)
+{
+  for(const size_t size : SIZES)
+  {
+    unsigned dtorCalled = 0;
+    std::vector<Optional<util::DtorCalled>> opts(size);
+
+    size_t engaged = 0;
+    for(size_t i = 0; i < size; i += 3)
+    {
+      ::new(static_cast<void*>(&opts[i])) Optional<util::DtorCalled>(util::DtorCalled{dtorCalled});
+      ++engaged;
+    }
+    dtorCalled = 0;
+
+    reset_all(opts.data(), opts.size());
+    EXPECT_EQ(engaged, dtorCalled) << size;
+
+    for(const auto &opt : opts)
+    {
+      EXPECT_FALSE(opt);
+    }
+
+    opts.clear();
+    EXPECT_EQ(engaged, dtorCalled) << size;
+  }
+}
+
+TEST(OptionalBatch, fillEngagedDtorCount)
+{
+  unsigned dtorCalled = 0;
+  const util::DtorCalled value{dtorCalled};
+
+  std::vector<Optional<util::DtorCalled>> opts(10);
+  for(size_t i = 0; i < opts.size(); i += 2)
+    ::new(static_cast<void*>(&opts[i])) Optional<util::DtorCalled>(value);
+  dtorCalled = 0;
+
+  // no assignment operator, the 5 engaged ones are destroyed and built again
+  fill_engaged(opts.data(), opts.size(), value);
+  EXPECT_EQ(5u, dtorCalled);
+
+  for(const auto &opt : opts)
+  {
+    EXPECT_TRUE(opt);
+  }
+
+  dtorCalled = 0;
+  reset_all(opts.data(), opts.size());
+  EXPECT_EQ(10u, dtorCalled);
+}
+
+TEST(OptionalBatch, fillEngagedReusesCapacity)
+{
+  std::vector<Optional<std::vector<int>>> opts(3);
+  opts[1] = std::vector<int>(100, 1);
+  const int *data = opts[1]->data();
+
+  fill_engaged(opts.data(), opts.size(), std::vector<int>(10, 2));
+  EXPECT_EQ(data, opts[1]->data());
+  EXPECT_EQ(10u, opts[0]->size());
+  EXPECT_EQ(2, (*opts[2])[9]);
+}
+
+TEST(OptionalBatch, optionalArray)
+{
+  for(const size_t size : SIZES)
+  {
+    OptionalArray<int64_t> arr(size);
+    for(size_t i = 0; i < size; i += 4)
+      arr.set(i, static_cast<int64_t>(i));
+
+    fill_engaged(arr, int64_t{9});
+    EXPECT_EQ(size, arr.count());
+    for(size_t i = 0; i < size; ++i)
+    {
+      EXPECT_EQ(9, *arr[i]);
+    }
+
+    // tail bits past size() stay clear
+    arr.resize(size + 1);
+    EXPECT_FALSE(arr.has_value(size));
+
+    reset_all(arr);
+    EXPECT_EQ(0u, arr.count());
+  }
+}
@@ -0,0 +1,238 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <OptionalColumnView.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+class TempFile
+{
+  std::string m_path;
+
+public:
+  TempFile()
+  {
+    char path[] = "/tmp/OptionalColumnView_UT_XXXXXX";
+    const int fd = ::mkstemp(path);
+    if(fd >= 0)
+      ::close(fd);
+
+    m_path = path;
+  }
+
+  ~TempFile()
+  {
+    std::remove(m_path.c_str());
+  }
+
+  const char* path() const { return m_path.c_str(); }
+};
+
+std::vector<Optional<int64_t>> make_column(size_t count, unsigned engagedPercent)
+{
+  std::vector<Optional<int64_t>> ret(count);
+  uint64_t state = 0x9E3779B97F4A7C15ull;
+  for(size_t i = 0; i < count; ++i)
+  {
+    state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+    if(state % 100 < engagedPercent)
+      ret[i] = static_cast<int64_t>(i) * 3 - 7;
+  }
+
+  return ret;
+}
+
+void write_file(const char *path, const std::vector<Optional<int64_t>> &first, const std::vector<Optional<double>> &second, uint64_t &secondOffset)
+{
+  std::FILE *file = std::fopen(path, "wb");
+  ASSERT_NE(nullptr, file);
+
+  OptionalFileSink sink{file};
+  OptionalWriter<OptionalFileSink> writer{sink};
+  writer.write(first);
+  writer.write(Optional<uint8_t>{}); // misaligns the stream, next block gets padded
+  secondOffset = detail::serial_align_up(writer.offset(), detail::serial_alignment<double>());
+  writer.write(second);
+
+  std::fclose(file);
+}
+
+void expect_matches(const OptionalColumnView<int64_t> &view, const std::vector<Optional<int64_t>> &column)
+{
+  ASSERT_EQ(column.size(), view.size());
+
+  size_t engaged = 0;
+  for(size_t i = 0; i < column.size(); ++i)
+  {
+    const Optional<const int64_t&> actual = view[i];
+    ASSERT_EQ(column[i].has_value(), actual.has_value()) << "at " << i;
+    ASSERT_EQ(column[i].has_value(), view.has_value(i)) << "at " << i;
+    if(column[i])
+    {
+      EXPECT_EQ(*column[i], *actual) << "at " << i;
+      ++engaged;
+    }
+  }
+
+  EXPECT_EQ(engaged, view.count());
+}
+
+} // namespace
+
+TEST(OptionalColumnView_UT, mapsWrittenColumns)
+{
+  const TempFile file;
+  const auto first = make_column(10000, 40);
+  std::vector<Optional<double>> second(3);
+  second[1] = 2.5;
+
+  uint64_t secondOffset = 0;
+  write_file(file.path(), first, second, secondOffset);
+
+  OptionalColumnView<int64_t> view;
+  ASSERT_TRUE(view.open(file.path()));
+  EXPECT_TRUE(view.is_open());
+  expect_matches(view, first);
+
+  OptionalColumnView<double> doubles;
+  ASSERT_TRUE(doubles.open(file.path(), secondOffset));
+  ASSERT_EQ(3u, doubles.size());
+  EXPECT_EQ(1u, doubles.count());
+  EXPECT_FALSE(doubles[0]);
+  ASSERT_TRUE(doubles[1]);
+  EXPECT_EQ(2.5, *doubles[1]);
+  EXPECT_FALSE(doubles[2]);
+}
+
+TEST(OptionalColumnView_UT, densitiesAndTails)
+{
+  for(const size_t count : {0u, 1u, 63u, 64u, 65u, 511u, 512u, 513u, 4097u})
+  {
+    for(const unsigned percent : {0u, 3u, 50u, 100u})
+    {
+      const auto column = make_column(count, percent);
+
+      std::vector<unsigned char> buffer;
+      OptionalBufferSink sink{buffer};
+      OptionalWriter<OptionalBufferSink> writer{sink};
+      writer.write(column);
+
+      std::vector<uint64_t> aligned((buffer.size() + 7) / 8);
+      std::memcpy(aligned.data(), buffer.data(), buffer.size());
+
+      OptionalColumnView<int64_t> view;
+      ASSERT_TRUE(view.attach(aligned.data(), buffer.size()));
+      expect_matches(view, column);
+    }
+  }
+}
+
+TEST(OptionalColumnView_UT, forEachEngaged)
+{
+  const auto column = make_column(3000, 20);
+
+  std::vector<unsigned char> buffer;
+  OptionalBufferSink sink{buffer};
+  OptionalWriter<OptionalBufferSink> writer{sink};
+  writer.write(column);
+
+  std::vector<uint64_t> aligned((buffer.size() + 7) / 8);
+  std::memcpy(aligned.data(), buffer.data(), buffer.size());
+
+  OptionalColumnView<int64_t> view;
+  ASSERT_TRUE(view.attach(aligned.data(), buffer.size()));
+
+  size_t visited = 0;
+  size_t last = 0;
+  view.for_each_engaged([&](size_t idx, const int64_t &val) {
+    EXPECT_TRUE(visited == 0 || idx > last);
+    ASSERT_TRUE(column[idx]);
+    EXPECT_EQ(*column[idx], val);
+    last = idx;
+    ++visited;
+  });
+
+  EXPECT_EQ(view.count(), visited);
+}
+
+TEST(OptionalColumnView_UT, rejectsBadInput)
+{
+  const TempFile file;
+  const auto column = make_column(1000, 50);
+  std::vector<Optional<double>> second(1);
+  uint64_t secondOffset = 0;
+  write_file(file.path(), column, second, secondOffset);
+
+  OptionalColumnView<int32_t> wrongType;
+  EXPECT_FALSE(wrongType.open(file.path()));
+  EXPECT_FALSE(wrongType.is_open());
+
+  OptionalColumnView<int64_t> missing;
+  EXPECT_FALSE(missing.open("/nonexistent/OptionalColumnView_UT"));
+
+  OptionalColumnView<int64_t> misaligned;
+  EXPECT_FALSE(misaligned.open(file.path(), 4));
+
+  std::vector<unsigned char> buffer;
+  OptionalBufferSink sink{buffer};
+  OptionalWriter<OptionalBufferSink> writer{sink};
+  writer.write(column);
+
+  std::vector<uint64_t> aligned((buffer.size() + 7) / 8);
+  std::memcpy(aligned.data(), buffer.data(), buffer.size());
+
+  OptionalColumnView<int64_t> truncated;
+  EXPECT_FALSE(truncated.attach(aligned.data(), buffer.size() - 8));
+  EXPECT_TRUE(truncated.attach(aligned.data(), buffer.size()));
+}
+
+TEST(OptionalColumnView_UT, moveKeepsMapping)
+{
+  const TempFile file;
+  const auto column = make_column(777, 60);
+  std::vector<Optional<double>> second(1);
+  uint64_t secondOffset = 0;
+  write_file(file.path(), column, second, secondOffset);
+
+  OptionalColumnView<int64_t> view;
+  ASSERT_TRUE(view.open(file.path()));
+
+  OptionalColumnView<int64_t> moved{std::move(view)};
+  EXPECT_FALSE(view.is_open());
+  expect_matches(moved, column);
+
+  view = std::move(moved);
+  expect_matches(view, column);
+}
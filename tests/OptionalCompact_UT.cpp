@@ -0,0 +1,270 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <OptionalCompact.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct FlagFirstId
+{
+  uint32_t id;
+};
+
+} // namespace
+
+namespace detail {
+
+template<>
+struct optional_flag_first<FlagFirstId> : std::true_type {};
+
+} // namespace detail
+
+namespace {
+
+const unsigned DENSITIES[] = {0, 1, 10, 50, 90, 99, 100};
+
+// every tail length of the 8, 16 and 64 wide steps
+const size_t SIZES[] = {0, 1, 7, 8, 9, 15, 16, 17, 31, 63, 64, 65, 127, 128, 129, 1000, 4099};
+
+template<typename T>
+struct Input
+{
+  std::vector<Optional<T>> span;
+  OptionalArray<T> array;
+  std::vector<T> expectedValues;
+  std::vector<uint32_t> expectedIdx;
+};
+
+template<typename T>
+Input<T> make_input(size_t count, unsigned engagedPercent)
+{
+  Input<T> ret{std::vector<Optional<T>>(count), OptionalArray<T>(count), {}, {}};
+
+  uint64_t state = 0x9E3779B97F4A7C15ull ^ (count * 131 + engagedPercent);
+  for(size_t i = 0; i < count; ++i)
+  {
+    state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+    if(state % 100 < engagedPercent)
+    {
+      const auto val = static_cast<T>(state % 100000);
+      ret.span[i] = val;
+      ret.array.set(i, val);
+      ret.expectedValues.push_back(val);
+      ret.expectedIdx.push_back(static_cast<uint32_t>(i));
+    }
+  }
+
+  return ret;
+}
+
+template<typename T>
+class OptionalCompactTyped : public ::testing::Test {};
+
+using PayloadTypes = ::testing::Types<int32_t, uint32_t, float, int64_t, double, uint16_t>;
+TYPED_TEST_SUITE(OptionalCompactTyped, PayloadTypes, );
+
+} // namespace
+
+TYPED_TEST(OptionalCompactTyped, spanAllDensitiesAndTails)
+{
+  using T = TypeParam;
+
+  for(const size_t size : SIZES)
+  {
+    for(const unsigned density : DENSITIES)
+    {
+      const auto input = make_input<T>(size, density);
+
+      std::vector<T> values(size);
+      std::vector<uint32_t> idx(size);
+      const size_t count = compact(input.span.data(), size, values.data(), idx.data());
+
+      ASSERT_EQ(input.expectedValues.size(), count) << size << " " << density;
+      values.resize(count);
+      idx.resize(count);
+      EXPECT_EQ(input.expectedValues, values) << size << " " << density;
+      EXPECT_EQ(input.expectedIdx, idx) << size << " " << density;
+    }
+  }
+}
+
+TYPED_TEST(OptionalCompactTyped, arrayAllDensitiesAndTails)
+{
+  using T = TypeParam;
+
+  for(const size_t size : SIZES)
+  {
+    for(const unsigned density : DENSITIES)
+    {
+      const auto input = make_input<T>(size, density);
+
+      std::vector<T> values(size);
+      std::vector<uint32_t> idx(size);
+      const size_t count = compact(input.array, values.data(), idx.data());
+
+      ASSERT_EQ(input.expectedValues.size(), count) << size << " " << density;
+      values.resize(count);
+      idx.resize(count);
+      EXPECT_EQ(input.expectedValues, values) << size << " " << density;
+      EXPECT_EQ(input.expectedIdx, idx) << size << " " << density;
+    }
+  }
+}
+
+TYPED_TEST(OptionalCompactTyped, exactRoomForEngaged)
+{
+  using T = TypeParam;
+
+  // what the vector returning compact of OptionalAlgorithm.hpp relies on, ASan catches a store past the end
+  for(const size_t size : SIZES)
+  {
+    for(const unsigned density : DENSITIES)
+    {
+      const auto input = make_input<T>(size, density);
+      const size_t engaged = input.expectedValues.size();
+
+      std::unique_ptr<T[]> values{new T[engaged]};
+      EXPECT_EQ(engaged, detail::compact_n(input.span.data(), size, values.get(), nullptr, engaged));
+      EXPECT_TRUE(std::equal(input.expectedValues.begin(), input.expectedValues.end(), values.get())) << size << " " << density;
+
+      std::unique_ptr<T[]> words{new T[engaged]};
+      EXPECT_EQ(engaged, detail::compact_words(input.array.bitmap(), input.array.values(), size, 0, input.array.bitmap_size(),
+          words.get(), nullptr));
+      EXPECT_TRUE(std::equal(input.expectedValues.begin(), input.expectedValues.end(), words.get())) << size << " " << density;
+    }
+  }
+}
+
+TYPED_TEST(OptionalCompactTyped, expandIsInverse)
+{
+  using T = TypeParam;
+
+  for(const size_t size : SIZES)
+  {
+    for(const unsigned density : DENSITIES)
+    {
+      const auto input = make_input<T>(size, density);
+
+      std::vector<T> values(size);
+      std::vector<uint32_t> idx(size);
+      const size_t count = compact(input.span.data(), size, values.data(), idx.data());
+
+      std::vector<Optional<T>> span(size, Optional<T>(T{1}));
+      expand(values.data(), idx.data(), count, span.data(), size);
+
+      OptionalArray<T> array(3);
+      array.set(0, T{1});
+      expand(values.data(), idx.data(), count, array, size);
+
+      ASSERT_EQ(size, array.size());
+      for(size_t i = 0; i < size; ++i)
+      {
+        ASSERT_EQ(input.span[i].has_value(), span[i].has_value()) << i;
+        ASSERT_EQ(input.span[i].has_value(), array.has_value(i)) << i;
+        if(input.span[i])
+        {
+          EXPECT_EQ(*input.span[i], *span[i]);
+          EXPECT_EQ(*input.span[i], *array[i]);
+        }
+      }
+    }
+  }
+}
+
+TEST(OptionalCompact, withoutIndices)
+{
+  const auto input = make_input<int32_t>(1000, 50);
+
+  std::vector<int32_t> values(1000);
+  ASSERT_EQ(input.expectedValues.size(), compact(input.span.data(), 1000, values.data()));
+  values.resize(input.expectedValues.size());
+  EXPECT_EQ(input.expectedValues, values);
+
+  values.assign(1000, 0);
+  ASSERT_EQ(input.expectedValues.size(), compact(input.array, values.data()));
+  values.resize(input.expectedValues.size());
+  EXPECT_EQ(input.expectedValues, values);
+}
+
+TEST(OptionalCompact, nonTrivialPayload)
+{
+  std::vector<Optional<std::string>> in(10);
+  in[1] = std::string("one");
+  in[4] = std::string("four");
+  in[9] = std::string("nine");
+
+  std::vector<std::string> values(in.size());
+  std::vector<uint32_t> idx(in.size());
+  ASSERT_EQ(3u, compact(in.data(), in.size(), values.data(), idx.data()));
+  EXPECT_EQ("one", values[0]);
+  EXPECT_EQ("four", values[1]);
+  EXPECT_EQ("nine", values[2]);
+  EXPECT_EQ(1u, idx[0]);
+  EXPECT_EQ(4u, idx[1]);
+  EXPECT_EQ(9u, idx[2]);
+
+  std::vector<Optional<std::string>> out(10, Optional<std::string>(std::string("stale")));
+  expand(values.data(), idx.data(), 3, out.data(), out.size());
+  for(size_t i = 0; i < out.size(); ++i)
+  {
+    ASSERT_EQ(in[i].has_value(), out[i].has_value()) << i;
+    if(in[i])
+    {
+      EXPECT_EQ(*in[i], *out[i]);
+    }
+  }
+}
+
+TEST(OptionalCompact, simdLayoutTrait)
+{
+  EXPECT_TRUE(detail::compact_simd_layout<int32_t>::value);
+  EXPECT_TRUE(detail::compact_simd_layout<double>::value);
+  EXPECT_FALSE(detail::compact_simd_layout<uint16_t>::value);
+  EXPECT_FALSE(detail::compact_simd_layout<std::string>::value);
+  EXPECT_FALSE(detail::compact_simd_layout<FlagFirstId>::value);
+}
+
+TEST(OptionalCompact, flagFirstPayload)
+{
+  std::vector<Optional<FlagFirstId>> in(100);
+  for(uint32_t i = 0; i < in.size(); i += 3)
+    in[i] = FlagFirstId{i};
+
+  std::vector<FlagFirstId> values(in.size());
+  std::vector<uint32_t> idx(in.size());
+  ASSERT_EQ(34u, compact(in.data(), in.size(), values.data(), idx.data()));
+  for(size_t k = 0; k < 34; ++k)
+  {
+    EXPECT_EQ(k * 3, values[k].id);
+    EXPECT_EQ(k * 3, idx[k]);
+  }
+}
@@ -0,0 +1,120 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <OptionalCoro.hpp>
+
+#include "Common.hpp"
+
+#include <string>
+#include <utility>
+
+namespace {
+
+Optional<int> sum(Optional<int> a, Optional<int> b)
+{
+  const int x = co_await a;
+  const int y = co_await b;
+  co_return x + y;
+}
+
+Optional<int> parse_digit(char c)
+{
+  if(c < '0' || c > '9')
+    return {};
+
+  return c - '0';
+}
+
+Optional<int> parse_number(const std::string &str)
+{
+  int ret = 0;
+  for(const char c : str)
+    ret = ret * 10 + co_await parse_digit(c);
+
+  co_return ret;
+}
+
+Optional<std::string> concat(const Optional<std::string> &a, Optional<std::string> &&b)
+{
+  std::string ret = co_await a;
+  ret += co_await std::move(b);
+  co_return ret;
+}
+
+Optional<int> forward_empty(unsigned &dtorCalled)
+{
+  const util::DtorCalled guard{dtorCalled};
+  co_await Optional<int>{};
+  co_return 1;
+}
+
+} // namespace
+
+TEST(OptionalCoro_20_UT, allEngaged)
+{
+  const auto val = sum(Optional<int>{2}, Optional<int>{3});
+
+  ASSERT_TRUE(val);
+  EXPECT_EQ(5, *val);
+}
+
+TEST(OptionalCoro_20_UT, shortCircuitOnEmpty)
+{
+  EXPECT_FALSE(sum(Optional<int>{}, Optional<int>{3}));
+  EXPECT_FALSE(sum(Optional<int>{2}, Optional<int>{}));
+  EXPECT_FALSE(sum(Optional<int>{}, Optional<int>{}));
+}
+
+TEST(OptionalCoro_20_UT, awaitInLoop)
+{
+  const auto val = parse_number("12345");
+
+  ASSERT_TRUE(val);
+  EXPECT_EQ(12345, *val);
+  EXPECT_FALSE(parse_number("12a45"));
+}
+
+TEST(OptionalCoro_20_UT, lvalueAndRvalueAwait)
+{
+  const Optional<std::string> a{std::string("foo")};
+  Optional<std::string> b{std::string("bar")};
+
+  const auto val = concat(a, std::move(b));
+
+  ASSERT_TRUE(val);
+  EXPECT_EQ("foobar", *val);
+  EXPECT_EQ("foo", *a);
+
+  EXPECT_FALSE(concat(Optional<std::string>{}, Optional<std::string>{std::string("bar")}));
+}
+
+TEST(OptionalCoro_20_UT, shortCircuitDestroysLocals)
+{
+  unsigned dtorCalled = 0;
+
+  EXPECT_FALSE(forward_empty(dtorCalled));
+  EXPECT_EQ(1u, dtorCalled);
+}
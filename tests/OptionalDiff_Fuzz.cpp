@@ -0,0 +1,393 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+// Differential harness: random sequences of operations applied in lockstep to Optional<T>
+// and std::optional<T>, comparing engaged state, values and how many times T got
+// constructed, assigned and destroyed on each side after every step.
+//
+// Built as a plain program (tests/runUT) it runs a fixed number of pseudo random inputs
+// from a fixed seed, then replays the decoded operations with checks and tracing off and
+// prints the time per operation on either side. Each row times a whole batch and divides by
+// its length, a clock read per operation would cost more than most operations do:
+//
+//   ./OptionalDiff_Fuzz [inputs] [seed]
+//
+// With -DPDY_OPTIONAL_LIBFUZZER and -fsanitize=fuzzer (make fuzz) libFuzzer drives
+// LLVMFuzzerTestOneInput instead. A mismatch prints the operation trace and aborts.
+
+#include <Optional.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct Counters
+{
+  uint64_t valueCtor = 0;
+  uint64_t copyCtor = 0;
+  uint64_t moveCtor = 0;
+  uint64_t copyAssign = 0;
+  uint64_t moveAssign = 0;
+  uint64_t dtor = 0;
+
+  bool operator==(const Counters &other) const
+  {
+    return valueCtor == other.valueCtor && copyCtor == other.copyCtor && moveCtor == other.moveCtor
+      && copyAssign == other.copyAssign && moveAssign == other.moveAssign && dtor == other.dtor;
+  }
+};
+
+// one instantiation per side, the heap allocated payload makes ASan see double destruction
+template<int Side>
+struct Tracked
+{
+  static Counters counters;
+
+  std::string payload;
+
+  explicit Tracked(int val)
+    : payload(static_cast<size_t>(val % 32) + 16, static_cast<char>('a' + val % 26))
+  {
+    ++counters.valueCtor;
+  }
+
+  Tracked(const Tracked &other)
+    : payload(other.payload)
+  {
+    ++counters.copyCtor;
+  }
+
+  Tracked(Tracked &&other) noexcept
+    : payload(std::move(other.payload))
+  {
+    ++counters.moveCtor;
+  }
+
+  Tracked& operator=(const Tracked &other)
+  {
+    payload = other.payload;
+    ++counters.copyAssign;
+    return *this;
+  }
+
+  Tracked& operator=(Tracked &&other) noexcept
+  {
+    payload = std::move(other.payload);
+    ++counters.moveAssign;
+    return *this;
+  }
+
+  ~Tracked()
+  {
+    ++counters.dtor;
+  }
+};
+
+template<int Side>
+Counters Tracked<Side>::counters;
+
+using Mine = Tracked<0>;
+using Theirs = Tracked<1>;
+
+enum Op : uint8_t
+{
+  ConstructValue,
+  ConstructEmpty,
+  CopyConstruct,
+  MoveConstruct,
+  CopyAssign,
+  MoveAssign,
+  AssignValue,
+  Swap,
+  Reset,
+  ValueOr,
+  OpCount
+};
+
+const char* const OP_NAMES[OpCount] = {
+  "construct(value)", "construct()", "copy construct", "move construct", "copy assign",
+  "move assign", "assign value", "swap", "reset", "value_or"
+};
+
+constexpr size_t SLOTS = 4;
+
+struct Step
+{
+  Op op;
+  uint8_t i;
+  uint8_t j;
+  int val;
+};
+
+// two bytes per operation
+void decode(const uint8_t *data, size_t size, std::vector<Step> &steps)
+{
+  for(size_t pos = 0; pos + 2 <= size; pos += 2)
+  {
+    Step step;
+    step.op = static_cast<Op>(data[pos] % OpCount);
+    step.i = static_cast<uint8_t>((data[pos] >> 4) % SLOTS);
+    step.j = static_cast<uint8_t>((data[pos + 1] >> 6) % SLOTS);
+    step.val = data[pos + 1] & 0x3F;
+    steps.push_back(step);
+  }
+}
+
+template<typename Opt, typename T>
+void apply(std::array<Opt, SLOTS> &slots, Op op, size_t i, size_t j, int val, std::string &valueOrResult)
+{
+  switch(op)
+  {
+    case ConstructValue:
+      slots[i].~Opt();
+      ::new(static_cast<void*>(&slots[i])) Opt(T(val));
+      break;
+    case ConstructEmpty:
+      slots[i].~Opt();
+      ::new(static_cast<void*>(&slots[i])) Opt();
+      break;
+    case CopyConstruct:
+      if(i != j)
+      {
+        slots[i].~Opt();
+        ::new(static_cast<void*>(&slots[i])) Opt(slots[j]);
+      }
+      break;
+    case MoveConstruct:
+      if(i != j)
+      {
+        slots[i].~Opt();
+        ::new(static_cast<void*>(&slots[i])) Opt(std::move(slots[j]));
+      }
+      break;
+    // i == j is self assignment, compared against std::optional like any other
+    case CopyAssign:
+      slots[i] = slots[j];
+      break;
+    case MoveAssign:
+      slots[i] = std::move(slots[j]);
+      break;
+    case AssignValue:
+      slots[i] = T(val);
+      break;
+    case Swap:
+    {
+      using std::swap;
+      swap(slots[i], slots[j]);
+      break;
+    }
+    case Reset:
+      slots[i].reset();
+      break;
+    case ValueOr:
+      valueOrResult = slots[i].value_or(T(val)).payload;
+      break;
+    case OpCount:
+      break;
+  }
+}
+
+struct Harness
+{
+  std::array<Optional<Mine>, SLOTS> mine;
+  std::array<std::optional<Theirs>, SLOTS> theirs;
+  std::vector<std::string> trace;
+
+  [[noreturn]] void fail(const char *what)
+  {
+    std::fprintf(stderr, "OptionalDiff: %s mismatch after:\n", what);
+    for(const auto &step : trace)
+      std::fprintf(stderr, "  %s\n", step.c_str());
+
+    std::abort();
+  }
+
+  void check()
+  {
+    for(size_t s = 0; s < SLOTS; ++s)
+    {
+      if(mine[s].has_value() != theirs[s].has_value())
+        fail("engaged state");
+
+      if(mine[s] && mine[s]->payload != theirs[s]->payload)
+        fail("value");
+    }
+
+    if(!(Mine::counters == Theirs::counters))
+      fail("constructor/assignment/destructor count");
+  }
+
+  void step(Op op, size_t i, size_t j, int val)
+  {
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%s slot %zu, slot %zu, value %d", OP_NAMES[op], i, j, val);
+    trace.emplace_back(buffer);
+
+    std::string mineValueOr;
+    std::string theirsValueOr;
+
+    apply<Optional<Mine>, Mine>(mine, op, i, j, val, mineValueOr);
+    apply<std::optional<Theirs>, Theirs>(theirs, op, i, j, val, theirsValueOr);
+
+    if(mineValueOr != theirsValueOr)
+      fail("value_or result");
+
+    check();
+  }
+};
+
+void run_input(const uint8_t *data, size_t size, std::vector<Step> &steps)
+{
+  const size_t first = steps.size();
+  decode(data, size, steps);
+
+  {
+    Harness harness;
+    for(size_t s = first; s < steps.size(); ++s)
+      harness.step(steps[s].op, steps[s].i, steps[s].j, steps[s].val);
+  }
+
+  // every slot destroyed, nothing may be left alive on either side
+  if(!(Mine::counters == Theirs::counters))
+  {
+    std::fprintf(stderr, "OptionalDiff: destructor count mismatch at the end of an input\n");
+    std::abort();
+  }
+
+  const Counters &c = Mine::counters;
+  if(c.valueCtor + c.copyCtor + c.moveCtor != c.dtor)
+  {
+    std::fprintf(stderr, "OptionalDiff: %llu objects leaked\n",
+        static_cast<unsigned long long>(c.valueCtor + c.copyCtor + c.moveCtor - c.dtor));
+    std::abort();
+  }
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+  std::vector<Step> steps;
+  run_input(data, size, steps);
+  return 0;
+}
+
+#if !defined(PDY_OPTIONAL_LIBFUZZER)
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// enough for milliseconds per batch, short enough for the sanitizer builds in tests/runUT
+constexpr size_t TIMING_STEPS = size_t{1} << 18;
+
+// keeps the value_or results observable, so the replay loop is not optimized away
+volatile size_t g_sink;
+
+// ns per step of one uninterrupted replay, slots start engaged
+template<typename Opt, typename T>
+double time_replay(const std::vector<Step> &steps)
+{
+  std::array<Opt, SLOTS> slots;
+  for(size_t s = 0; s < SLOTS; ++s)
+    slots[s] = T(static_cast<int>(s));
+
+  std::string valueOr;
+  size_t sink = 0;
+
+  const auto start = Clock::now();
+  for(const auto &step : steps)
+  {
+    apply<Opt, T>(slots, step.op, step.i, step.j, step.val, valueOr);
+    sink += valueOr.size();
+  }
+  const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+
+  g_sink = sink;
+  return static_cast<double>(ns) / static_cast<double>(steps.empty() ? 1 : steps.size());
+}
+
+void print_timing(const char *name, const std::vector<Step> &steps)
+{
+  std::printf("%-20s %12zu %16.1f %16.1f\n", name, steps.size(),
+      time_replay<Optional<Mine>, Mine>(steps), time_replay<std::optional<Theirs>, Theirs>(steps));
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  const unsigned long inputs = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+  unsigned long long state = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 0x9E3779B97F4A7C15ull;
+  if(state == 0)
+    state = 1;
+
+  std::vector<uint8_t> input;
+  std::vector<Step> steps;
+  for(unsigned long n = 0; n < inputs; ++n)
+  {
+    input.resize(2 + (state % 256));
+    for(auto &byte : input)
+    {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      byte = static_cast<uint8_t>(state >> 32);
+    }
+
+    run_input(input.data(), input.size(), steps);
+  }
+
+  std::printf("OptionalDiff: %lu inputs, no mismatch\n", inputs);
+
+  // the whole decoded stream, then each operation alone on the same slots and values:
+  // with every step the same operation its both engaged path dominates, reset aside
+  if(steps.size() > TIMING_STEPS)
+    steps.resize(TIMING_STEPS);
+
+  std::printf("%-20s %12s %16s %16s\n", "operation", "steps", "Optional ns/op", "std::optional ns/op");
+  print_timing("mixed", steps);
+
+  std::vector<Step> single(steps);
+  for(unsigned op = 0; op < OpCount; ++op)
+  {
+    for(auto &step : single)
+      step.op = static_cast<Op>(op);
+
+    print_timing(OP_NAMES[op], single);
+  }
+
+  return 0;
+}
+
+#endif
@@ -0,0 +1,132 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <OptionalIndex.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<Optional<int64_t>> make_stream(size_t count, unsigned engagedPerMille)
+{
+  std::vector<Optional<int64_t>> ret(count);
+
+  uint64_t state = 0x2545F4914F6CDD1Dull ^ count;
+  for(size_t i = 0; i < count; ++i)
+  {
+    state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+    if(state % 1000 < engagedPerMille)
+      ret[i] = static_cast<int64_t>(state % 100000);
+  }
+
+  return ret;
+}
+
+} // namespace
+
+TEST(OptionalIndex, empty)
+{
+  const OptionalIndex<int> index;
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(0u, index.count());
+
+  const auto built = OptionalIndexBuilder<int>().build();
+  EXPECT_EQ(0u, built.size());
+}
+
+TEST(OptionalIndex, matchesStream)
+{
+  for(const size_t size : {1u, 63u, 64u, 65u, 511u, 512u, 513u, 10000u})
+  {
+    for(const unsigned perMille : {0u, 1u, 10u, 100u, 500u, 1000u})
+    {
+      const auto stream = make_stream(size, perMille);
+      const auto index = make_optional_index(stream.begin(), stream.end());
+
+      ASSERT_EQ(size, index.size());
+
+      size_t count = 0;
+      for(size_t i = 0; i < size; ++i)
+      {
+        const auto opt = index.at(i);
+        ASSERT_EQ(stream[i].has_value(), opt.has_value()) << size << " " << perMille << " " << i;
+        ASSERT_EQ(stream[i].has_value(), index.has_value(i));
+        if(opt)
+        {
+          ++count;
+          EXPECT_EQ(*stream[i], *opt);
+          EXPECT_EQ(&*opt, &*index[i]);
+        }
+      }
+
+      EXPECT_EQ(count, index.count());
+    }
+  }
+}
+
+TEST(OptionalIndex, builderRunsAndMoves)
+{
+  OptionalIndexBuilder<std::string> builder;
+  builder.push_empty(100);
+  builder.push_back(Optional<std::string>(std::string("a")));
+  builder.push_empty(1000);
+  Optional<std::string> b(std::string("b"));
+  builder.push_back(b);
+  builder.push_back(Optional<std::string>());
+  EXPECT_EQ(1103u, builder.size());
+
+  const auto index = std::move(builder).build();
+  ASSERT_EQ(1103u, index.size());
+  ASSERT_EQ(2u, index.count());
+  EXPECT_FALSE(index[0]);
+  EXPECT_FALSE(index[99]);
+  EXPECT_EQ("a", *index[100]);
+  EXPECT_FALSE(index[101]);
+  EXPECT_EQ("b", *index[1101]);
+  EXPECT_FALSE(index[1102]);
+  EXPECT_EQ("b", *b);
+
+  std::vector<size_t> seen;
+  index.for_each_engaged([&](size_t idx, const std::string &val) {
+    seen.push_back(idx);
+    EXPECT_EQ(idx == 100 ? "a" : "b", val);
+  });
+  EXPECT_EQ((std::vector<size_t>{100, 1101}), seen);
+
+  EXPECT_EQ(0u, builder.size());
+}
+
+TEST(OptionalIndex, memory)
+{
+  const auto stream = make_stream(1 << 16, 5);
+  const auto index = make_optional_index(stream.begin(), stream.end());
+
+  const size_t bitmapBytes = (1 << 16) / 8;
+  EXPECT_LE(index.memory_usage(), bitmapBytes + bitmapBytes / 8 + 16 + index.count() * sizeof(int64_t));
+  EXPECT_LT(index.memory_usage(), stream.size() * sizeof(Optional<int64_t>) / 8);
+}
@@ -0,0 +1,202 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <OptionalPack.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace {
+
+constexpr Optional<int> CONST_ENGAGED{7};
+constexpr Optional<int> CONST_EMPTY{};
+
+static_assert(optional_mask(CONST_ENGAGED, CONST_EMPTY, CONST_ENGAGED) == 0x5, "");
+static_assert(optional_any(CONST_EMPTY, CONST_ENGAGED), "");
+static_assert(!optional_any(CONST_EMPTY, CONST_EMPTY), "");
+static_assert(optional_all(CONST_ENGAGED, CONST_ENGAGED), "");
+static_assert(!optional_all(CONST_ENGAGED, CONST_EMPTY), "");
+static_assert(detail::pack_full_mask<64>() == ~uint64_t{0}, "");
+static_assert(detail::pack_full_mask<3>() == 0x7, "");
+
+} // namespace
+
+TEST(OptionalPack, maskBitPerArgument)
+{
+  Optional<int> a{1};
+  Optional<std::string> b;
+  Optional<double> c{2.0};
+  Optional<std::string> d{"d"};
+
+  EXPECT_EQ(0xDu, optional_mask(a, b, c, d));
+  EXPECT_EQ(0x1u, optional_mask(a));
+  EXPECT_EQ(0x0u, optional_mask(b));
+  EXPECT_EQ(0x0u, optional_mask());
+
+  b = std::string("b");
+  EXPECT_EQ(0xFu, optional_mask(a, b, c, d));
+
+  a.reset();
+  d.reset();
+  EXPECT_EQ(0x6u, optional_mask(a, b, c, d));
+}
+
+TEST(OptionalPack, maskManyArguments)
+{
+  Optional<int> on{1};
+  Optional<int> off;
+
+  EXPECT_EQ(0x2AAu, optional_mask(off, on, off, on, off, on, off, on, off, on));
+  EXPECT_EQ(uint64_t{1} << 11, optional_mask(off, off, off, off, off, off, off, off, off, off, off, on));
+}
+
+TEST(OptionalPack, maskOfReferences)
+{
+  int value = 3;
+  Optional<int&> ref{value};
+  Optional<int&> none;
+
+  EXPECT_EQ(0x1u, optional_mask(ref, none));
+}
+
+TEST(OptionalPack, anyAll)
+{
+  Optional<int> a{1};
+  Optional<int> b;
+
+  EXPECT_TRUE(optional_any(a, b));
+  EXPECT_FALSE(optional_all(a, b));
+  EXPECT_TRUE(optional_all(a));
+  EXPECT_FALSE(optional_any(b));
+
+  EXPECT_FALSE(optional_any());
+  EXPECT_TRUE(optional_all());
+}
+
+TEST(OptionalPack, applyWhenAllEngaged)
+{
+  Optional<int> a{2};
+  Optional<std::string> b{"ab"};
+  Optional<double> c{0.5};
+
+  int calls = 0;
+  const auto f = [&calls](int x, const std::string &s, double d) {
+    ++calls;
+    return static_cast<double>(x) + static_cast<double>(s.size()) + d;
+  };
+
+  const Optional<double> ret = optional_apply(f, a, b, c);
+  ASSERT_TRUE(ret.has_value());
+  EXPECT_DOUBLE_EQ(4.5, *ret);
+  EXPECT_EQ(1, calls);
+
+  b.reset();
+  EXPECT_FALSE(optional_apply(f, a, b, c).has_value());
+  EXPECT_EQ(1, calls);
+}
+
+TEST(OptionalPack, applyResultValueOr)
+{
+  Optional<int> a{2};
+  Optional<int> b;
+
+  const auto mul = [](int x, int y) { return x * y; };
+
+  EXPECT_EQ(-1, optional_apply(mul, a, b).value_or(-1));
+  b = 5;
+  EXPECT_EQ(10, optional_apply(mul, a, b).value_or(-1));
+}
+
+TEST(OptionalPack, applyVoidReturnsWhetherCalled)
+{
+  Optional<int> a{2};
+  Optional<int> b{3};
+
+  int sum = 0;
+  const auto add = [&sum](int x, int y) { sum = x + y; };
+
+  EXPECT_TRUE(optional_apply(add, a, b));
+  EXPECT_EQ(5, sum);
+
+  a.reset();
+  sum = 0;
+  EXPECT_FALSE(optional_apply(add, a, b));
+  EXPECT_EQ(0, sum);
+}
+
+TEST(OptionalPack, applyPassesLvaluesByReference)
+{
+  Optional<int> a{1};
+  Optional<std::string> b{"x"};
+
+  EXPECT_TRUE(optional_apply([](int &x, std::string &s) { x = 10; s += "y"; }, a, b));
+  EXPECT_EQ(10, *a);
+  EXPECT_EQ("xy", *b);
+}
+
+TEST(OptionalPack, applyMovesFromRvalues)
+{
+  Optional<std::unique_ptr<int>> a{std::unique_ptr<int>(new int(4))};
+  Optional<std::string> b{std::string(64, 'm')};
+
+  const auto take = [](std::unique_ptr<int> p, std::string s) { return *p + static_cast<int>(s.size()); };
+
+  const Optional<int> ret = optional_apply(take, std::move(a), std::move(b));
+  ASSERT_TRUE(ret.has_value());
+  EXPECT_EQ(68, *ret);
+
+  // moved-from payloads, the Optionals themselves stay engaged
+  ASSERT_TRUE(a.has_value());
+  EXPECT_EQ(nullptr, *a);
+  ASSERT_TRUE(b.has_value());
+  EXPECT_TRUE(b->empty());
+}
+
+TEST(OptionalPack, applyEmptyDoesNotMove)
+{
+  Optional<std::string> a{std::string(64, 'k')};
+  Optional<std::string> b;
+
+  const auto take = [](std::string x, std::string y) { return x + y; };
+
+  EXPECT_FALSE(optional_apply(take, std::move(a), std::move(b)).has_value());
+  ASSERT_TRUE(a.has_value());
+  EXPECT_EQ(64u, a->size());
+}
+
+TEST(OptionalPack, applyReturningReference)
+{
+  Optional<std::string> a{"ref"};
+  Optional<int> b{1};
+
+  const auto pick = [](std::string &s, int) -> std::string& { return s; };
+
+  Optional<std::string&> ret = optional_apply(pick, a, b);
+  ASSERT_TRUE(ret.has_value());
+  *ret = "changed";
+  EXPECT_EQ("changed", *a);
+}
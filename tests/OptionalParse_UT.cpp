@@ -0,0 +1,282 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <OptionalParse.hpp>
+
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace {
+
+template<typename T>
+Optional<T> parse_str(const std::string &str)
+{
+  return parse<T>(str.data(), str.data() + str.size());
+}
+
+// strtoll/strtod restricted to the grammar parse<T> accepts:
+// no leading whitespace, no hex, inf or nan, the whole string consumed, no ERANGE
+bool reference_charset(const std::string &str, const char *allowed)
+{
+  return !str.empty() && str.find_first_not_of(allowed) == std::string::npos;
+}
+
+Optional<int64_t> reference_int64(const std::string &str)
+{
+  if(!reference_charset(str, "0123456789+-"))
+    return Optional<int64_t>();
+
+  errno = 0;
+  char *end = nullptr;
+  const long long ret = std::strtoll(str.c_str(), &end, 10);
+  if(end != str.c_str() + str.size() || errno != 0)
+    return Optional<int64_t>();
+
+  return static_cast<int64_t>(ret);
+}
+
+// sets 'skip' when strtod reports ERANGE, the two may disagree on denormals there
+template<typename T>
+Optional<T> reference_float(const std::string &str, bool &skip)
+{
+  skip = false;
+  if(!reference_charset(str, "0123456789+-.eE"))
+    return Optional<T>();
+
+  errno = 0;
+  char *end = nullptr;
+  const T ret = std::is_same<T, float>::value ? static_cast<T>(std::strtof(str.c_str(), &end)) : static_cast<T>(std::strtod(str.c_str(), &end));
+  if(end != str.c_str() + str.size())
+    return Optional<T>();
+
+  skip = errno == ERANGE;
+  return ret;
+}
+
+struct Rng
+{
+  uint64_t state = 0x9E3779B97F4A7C15ull;
+
+  uint64_t next()
+  {
+    state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+    return state;
+  }
+};
+
+// mostly number shaped strings, with random junk spliced in
+std::string random_input(Rng &rng)
+{
+  static const char ALPHABET[] = "0123456789000+-.eE x";
+
+  char buffer[64];
+  std::string ret;
+  switch(rng.next() % 6)
+  {
+    case 0:
+      std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(rng.next()) >> (rng.next() % 64));
+      ret = buffer;
+      break;
+    case 1:
+    {
+      double val;
+      const uint64_t bits = rng.next();
+      std::memcpy(&val, &bits, sizeof(val));
+      std::snprintf(buffer, sizeof(buffer), "%.*g", static_cast<int>(rng.next() % 20), val);
+      ret = buffer;
+      break;
+    }
+    case 2:
+      std::snprintf(buffer, sizeof(buffer), "%.*f", static_cast<int>(rng.next() % 12),
+          static_cast<double>(rng.next() % 100000000) / static_cast<double>(1 + rng.next() % 1000));
+      ret = buffer;
+      break;
+    case 3:
+      std::snprintf(buffer, sizeof(buffer), "%llue%d", static_cast<unsigned long long>(rng.next() % 100000),
+          static_cast<int>(rng.next() % 80) - 40);
+      ret = buffer;
+      break;
+    default:
+    {
+      const size_t len = rng.next() % 30;
+      for(size_t i = 0; i < len; ++i)
+        ret += ALPHABET[rng.next() % (sizeof(ALPHABET) - 1)];
+      break;
+    }
+  }
+
+  if(!ret.empty() && rng.next() % 8 == 0)
+    ret[rng.next() % ret.size()] = ALPHABET[rng.next() % (sizeof(ALPHABET) - 1)];
+
+  return ret;
+}
+
+} // namespace
+
+TEST(OptionalParse, integers)
+{
+  EXPECT_EQ(0, *parse_str<int>("0"));
+  EXPECT_EQ(42, *parse_str<int>("+42"));
+  EXPECT_EQ(-42, *parse_str<int>("-42"));
+  EXPECT_EQ(123456789012345678ll, *parse_str<int64_t>("123456789012345678"));
+  EXPECT_EQ(7, *parse_str<int64_t>("00000000000000000000000007"));
+
+  EXPECT_EQ(std::numeric_limits<int64_t>::max(), *parse_str<int64_t>("9223372036854775807"));
+  EXPECT_EQ(std::numeric_limits<int64_t>::min(), *parse_str<int64_t>("-9223372036854775808"));
+  EXPECT_FALSE(parse_str<int64_t>("9223372036854775808"));
+  EXPECT_FALSE(parse_str<int64_t>("-9223372036854775809"));
+
+  EXPECT_EQ(std::numeric_limits<uint64_t>::max(), *parse_str<uint64_t>("18446744073709551615"));
+  EXPECT_FALSE(parse_str<uint64_t>("18446744073709551616"));
+  EXPECT_FALSE(parse_str<uint64_t>("-1"));
+
+  EXPECT_EQ(127, *parse_str<int8_t>("127"));
+  EXPECT_EQ(-128, *parse_str<int8_t>("-128"));
+  EXPECT_FALSE(parse_str<int8_t>("128"));
+  EXPECT_EQ(65535, *parse_str<uint16_t>("65535"));
+  EXPECT_FALSE(parse_str<uint16_t>("65536"));
+
+  for(const char *bad : {"", "-", "+", " 1", "1 ", "1a", "a1", "1.0", "0x10", "--1", "12345678a"})
+  {
+    EXPECT_FALSE(parse_str<int64_t>(bad)) << bad;
+  }
+}
+
+TEST(OptionalParse, floats)
+{
+  EXPECT_EQ(0.0, *parse_str<double>("0"));
+  EXPECT_TRUE(std::signbit(*parse_str<double>("-0.0")));
+  EXPECT_EQ(1.5, *parse_str<double>("1.5"));
+  EXPECT_EQ(0.5, *parse_str<double>(".5"));
+  EXPECT_EQ(5.0, *parse_str<double>("5."));
+  EXPECT_EQ(-1250.0, *parse_str<double>("-1.25e3"));
+  EXPECT_EQ(1.25e-3, *parse_str<double>("+1.25E-3"));
+  EXPECT_EQ(0.1, *parse_str<double>("0.1"));
+  EXPECT_EQ(1e300, *parse_str<double>("1e300"));
+  EXPECT_EQ(123456789012345678901234567890.0, *parse_str<double>("123456789012345678901234567890"));
+  EXPECT_EQ(0.3f, *parse_str<float>("0.3"));
+  EXPECT_EQ(3.4028235e38f, *parse_str<float>("3.4028235e38"));
+
+  EXPECT_FALSE(parse_str<double>("1e400"));
+  EXPECT_FALSE(parse_str<float>("1e39"));
+
+  for(const char *bad : {"", ".", "-", "e5", ".e5", "1e", "1e+", "1.2.3", "inf", "nan", "0x1p3", " 1", "1 ", "1,5"})
+  {
+    EXPECT_FALSE(parse_str<double>(bad)) << bad;
+  }
+}
+
+TEST(OptionalParse, fuzzAgainstStrtoll)
+{
+  Rng rng;
+  for(unsigned i = 0; i < 200000; ++i)
+  {
+    const std::string input = random_input(rng);
+    const auto expected = reference_int64(input);
+    const auto actual = parse_str<int64_t>(input);
+
+    ASSERT_EQ(expected.has_value(), actual.has_value()) << "'" << input << "'";
+    if(expected)
+    {
+      ASSERT_EQ(*expected, *actual) << "'" << input << "'";
+    }
+  }
+}
+
+TEST(OptionalParse, fuzzAgainstStrtod)
+{
+  Rng rng;
+  for(unsigned i = 0; i < 200000; ++i)
+  {
+    const std::string input = random_input(rng);
+
+    bool skip = false;
+    const auto expected = reference_float<double>(input, skip);
+    if(skip)
+      continue;
+
+    const auto actual = parse_str<double>(input);
+    ASSERT_EQ(expected.has_value(), actual.has_value()) << "'" << input << "'";
+    if(expected)
+    {
+      ASSERT_EQ(*expected, *actual) << "'" << input << "'";
+    }
+
+    const auto expectedFloat = reference_float<float>(input, skip);
+    if(skip)
+      continue;
+
+    const auto actualFloat = parse_str<float>(input);
+    ASSERT_EQ(expectedFloat.has_value(), actualFloat.has_value()) << "'" << input << "'";
+    if(expectedFloat)
+    {
+      ASSERT_EQ(*expectedFloat, *actualFloat) << "'" << input << "'";
+    }
+  }
+}
+
+TEST(OptionalParse, fields)
+{
+  const std::string line = "1,,-3,x,5";
+  OptionalArray<int64_t> column;
+  EXPECT_EQ(3u, parse_fields(line.data(), line.data() + line.size(), ',', column));
+
+  ASSERT_EQ(5u, column.size());
+  EXPECT_EQ(1, *column[0]);
+  EXPECT_FALSE(column[1]);
+  EXPECT_EQ(-3, *column[2]);
+  EXPECT_FALSE(column[3]);
+  EXPECT_EQ(5, *column[4]);
+
+  const std::string trailing = "2.5,";
+  OptionalArray<double> doubles;
+  EXPECT_EQ(1u, parse_fields(trailing.data(), trailing.data() + trailing.size(), ',', doubles));
+  ASSERT_EQ(2u, doubles.size());
+  EXPECT_EQ(2.5, *doubles[0]);
+  EXPECT_FALSE(doubles[1]);
+}
+
+TEST(OptionalParse, range)
+{
+  const std::vector<std::string> fields = {"1.5", "", "abc", "-2e2"};
+
+  OptionalArray<double> column(1);
+  EXPECT_EQ(2u, parse_range(fields.begin(), fields.end(), column));
+
+  ASSERT_EQ(5u, column.size());
+  EXPECT_FALSE(column[0]);
+  EXPECT_EQ(1.5, *column[1]);
+  EXPECT_FALSE(column[2]);
+  EXPECT_FALSE(column[3]);
+  EXPECT_EQ(-200.0, *column[4]);
+}
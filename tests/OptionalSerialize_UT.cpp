@@ -0,0 +1,310 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <OptionalSerialize.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+struct Point
+{
+  int16_t x;
+  int64_t y;
+
+  bool operator==(const Point &other) const { return x == other.x && y == other.y; }
+};
+
+struct alignas(32) Wide
+{
+  unsigned char bytes[32];
+};
+
+template<typename T, typename Gen>
+std::vector<Optional<T>> make_column(size_t count, unsigned engagedPercent, Gen gen)
+{
+  std::vector<Optional<T>> ret(count);
+  uint64_t state = 0x2545F4914F6CDD1Dull + count;
+  for(size_t i = 0; i < count; ++i)
+  {
+    state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+    if(state % 100 < engagedPercent)
+      ret[i] = gen(i);
+  }
+
+  return ret;
+}
+
+// a source that can't tell how much is left, like a pipe
+class StreamSource
+{
+  OptionalBufferSource m_source;
+
+public:
+  StreamSource(const void *data, size_t size) noexcept
+    : m_source{data, size}
+  {}
+
+  size_t read(void *data, size_t size) noexcept { return m_source.read(data, size); }
+};
+
+template<typename T>
+void expect_same(const std::vector<Optional<T>> &expected, const std::vector<Optional<T>> &actual)
+{
+  ASSERT_EQ(expected.size(), actual.size());
+  for(size_t i = 0; i < expected.size(); ++i)
+  {
+    ASSERT_EQ(expected[i].has_value(), actual[i].has_value()) << "at " << i;
+    if(expected[i])
+    {
+      EXPECT_EQ(*expected[i], *actual[i]) << "at " << i;
+    }
+  }
+}
+
+template<typename T, typename Gen>
+void round_trip(size_t count, unsigned engagedPercent, Gen gen)
+{
+  const auto column = make_column<T>(count, engagedPercent, gen);
+
+  std::vector<unsigned char> buffer;
+  OptionalBufferSink sink{buffer};
+  OptionalWriter<OptionalBufferSink> writer{sink};
+  writer.write(column);
+
+  EXPECT_EQ(buffer.size(), writer.offset());
+
+  OptionalBufferSource source{buffer.data(), buffer.size()};
+  OptionalReader<OptionalBufferSource> reader{source};
+
+  std::vector<Optional<T>> actual;
+  ASSERT_TRUE(reader.read(actual));
+  expect_same(column, actual);
+  EXPECT_EQ(buffer.size(), reader.offset());
+}
+
+} // namespace
+
+TEST(OptionalSerialize_UT, roundTripDensitiesAndTails)
+{
+  for(const size_t count : {0u, 1u, 63u, 64u, 65u, 127u, 128u, 1000u, 5000u})
+  {
+    for(const unsigned percent : {0u, 1u, 50u, 99u, 100u})
+    {
+      round_trip<int64_t>(count, percent, [](size_t i) { return static_cast<int64_t>(i * 7919) - 1000; });
+      round_trip<uint8_t>(count, percent, [](size_t i) { return static_cast<uint8_t>(i); });
+      round_trip<double>(count, percent, [](size_t i) { return static_cast<double>(i) / 3.0; });
+      round_trip<Point>(count, percent, [](size_t i) { return Point{static_cast<int16_t>(i), static_cast<int64_t>(i) << 33}; });
+    }
+  }
+}
+
+TEST(OptionalSerialize_UT, byteLayout)
+{
+  std::vector<Optional<uint16_t>> column(3);
+  column[0] = uint16_t{0x0102};
+  column[2] = uint16_t{0x0304};
+
+  std::vector<unsigned char> buffer;
+  OptionalBufferSink sink{buffer};
+  OptionalWriter<OptionalBufferSink> writer{sink};
+  writer.write(column);
+
+  const std::vector<unsigned char> expected = {
+    'P', 'O', 'P', 'T',   // magic
+    1, 0,                 // version
+    2, 0,                 // sizeof(T)
+    3, 0, 0, 0, 0, 0, 0, 0, // count
+    0x05, 0, 0, 0, 0, 0, 0, 0, // bitmap: elements 0 and 2
+    0x02, 0x01, 0x04, 0x03 // values
+  };
+
+  EXPECT_EQ(expected, buffer);
+}
+
+TEST(OptionalSerialize_UT, multipleBlocksKeepAlignment)
+{
+  const auto bytes = make_column<uint8_t>(5, 100, [](size_t i) { return static_cast<uint8_t>(i); });
+
+  std::vector<Optional<Wide>> wides(3);
+  Wide wide{};
+  wide.bytes[0] = 42;
+  wides[1] = wide;
+
+  std::vector<unsigned char> buffer;
+  OptionalBufferSink sink{buffer};
+  OptionalWriter<OptionalBufferSink> writer{sink};
+  writer.write(bytes);
+  writer.write(wides);
+  writer.write(Optional<int32_t>{7});
+  writer.write(Optional<int32_t>{});
+
+  OptionalBufferSource source{buffer.data(), buffer.size()};
+  OptionalReader<OptionalBufferSource> reader{source};
+
+  std::vector<Optional<uint8_t>> actualBytes;
+  std::vector<Optional<Wide>> actualWides;
+  Optional<int32_t> engaged;
+  Optional<int32_t> empty{3};
+
+  ASSERT_TRUE(reader.read(actualBytes));
+  ASSERT_TRUE(reader.read(actualWides));
+  ASSERT_TRUE(reader.read(engaged));
+  ASSERT_TRUE(reader.read(empty));
+
+  expect_same(bytes, actualBytes);
+  ASSERT_EQ(3u, actualWides.size());
+  EXPECT_FALSE(actualWides[0]);
+  ASSERT_TRUE(actualWides[1]);
+  EXPECT_EQ(42, actualWides[1]->bytes[0]);
+  EXPECT_FALSE(actualWides[2]);
+  ASSERT_TRUE(engaged);
+  EXPECT_EQ(7, *engaged);
+  EXPECT_FALSE(empty);
+
+  std::vector<Optional<uint8_t>> pastEnd;
+  EXPECT_FALSE(reader.read(pastEnd));
+}
+
+TEST(OptionalSerialize_UT, rejectsMalformedInput)
+{
+  const auto column = make_column<int32_t>(100, 50, [](size_t i) { return static_cast<int32_t>(i); });
+
+  std::vector<unsigned char> buffer;
+  OptionalBufferSink sink{buffer};
+  OptionalWriter<OptionalBufferSink> writer{sink};
+  writer.write(column);
+
+  {
+    // value size mismatch
+    OptionalBufferSource source{buffer.data(), buffer.size()};
+    OptionalReader<OptionalBufferSource> reader{source};
+    std::vector<Optional<int64_t>> out;
+    EXPECT_FALSE(reader.read(out));
+  }
+
+  {
+    // truncated, whatever was appended before stays, nothing else does
+    OptionalBufferSource source{buffer.data(), buffer.size() - 1};
+    OptionalReader<OptionalBufferSource> reader{source};
+    std::vector<Optional<int32_t>> out(3, Optional<int32_t>{7});
+    EXPECT_FALSE(reader.read(out));
+    ASSERT_EQ(3u, out.size());
+    EXPECT_EQ(7, *out[2]);
+  }
+
+  {
+    // truncated inside the values, on a source without remaining()
+    StreamSource source{buffer.data(), buffer.size() - 1};
+    OptionalReader<StreamSource> reader{source};
+    std::vector<Optional<int32_t>> out;
+    EXPECT_FALSE(reader.read(out));
+    EXPECT_TRUE(out.empty());
+  }
+
+  {
+    auto corrupted = buffer;
+    corrupted[0] = 'X';
+    OptionalBufferSource source{corrupted.data(), corrupted.size()};
+    OptionalReader<OptionalBufferSource> reader{source};
+    std::vector<Optional<int32_t>> out;
+    EXPECT_FALSE(reader.read(out));
+    EXPECT_TRUE(out.empty());
+  }
+
+  {
+    // bit set past the element count
+    auto corrupted = buffer;
+    corrupted[detail::SERIAL_HEADER_SIZE + 15] |= 0x80;
+    OptionalBufferSource source{corrupted.data(), corrupted.size()};
+    OptionalReader<OptionalBufferSource> reader{source};
+    std::vector<Optional<int32_t>> out;
+    EXPECT_FALSE(reader.read(out));
+    EXPECT_TRUE(out.empty());
+  }
+}
+
+TEST(OptionalSerialize_UT, rejectsHugeCount)
+{
+  for(const uint64_t count : {uint64_t{1} << 40, UINT64_MAX - 10, UINT64_MAX})
+  {
+    unsigned char header[detail::SERIAL_HEADER_SIZE];
+    detail::serial_encode_header(header, sizeof(int32_t), count);
+
+    {
+      OptionalBufferSource source{header, sizeof(header)};
+      OptionalReader<OptionalBufferSource> reader{source};
+      std::vector<Optional<int32_t>> out;
+      EXPECT_FALSE(reader.read(out));
+      EXPECT_TRUE(out.empty());
+    }
+
+    {
+      StreamSource source{header, sizeof(header)};
+      OptionalReader<StreamSource> reader{source};
+      std::vector<Optional<int32_t>> out;
+      EXPECT_FALSE(reader.read(out));
+      EXPECT_TRUE(out.empty());
+    }
+  }
+}
+
+TEST(OptionalSerialize_UT, countBeyondValues)
+{
+  // the whole bitmap is there and claims every element, the values are missing
+  std::vector<unsigned char> buffer(detail::SERIAL_HEADER_SIZE + 8 * 16, 0xFF);
+  detail::serial_encode_header(buffer.data(), sizeof(int64_t), 1024);
+
+  OptionalBufferSource source{buffer.data(), buffer.size()};
+  OptionalReader<OptionalBufferSource> reader{source};
+  std::vector<Optional<int64_t>> out;
+  EXPECT_FALSE(reader.read(out));
+  EXPECT_TRUE(out.empty());
+}
+
+TEST(OptionalSerialize_UT, fileRoundTrip)
+{
+  const auto column = make_column<double>(3000, 30, [](size_t i) { return static_cast<double>(i) * 0.5; });
+
+  std::FILE *file = std::tmpfile();
+  ASSERT_NE(nullptr, file);
+
+  OptionalFileSink sink{file};
+  OptionalWriter<OptionalFileSink> writer{sink};
+  writer.write(column);
+
+  std::rewind(file);
+
+  OptionalFileSource source{file};
+  OptionalReader<OptionalFileSource> reader{source};
+  std::vector<Optional<double>> actual;
+  ASSERT_TRUE(reader.read(actual));
+  std::fclose(file);
+
+  expect_same(column, actual);
+}
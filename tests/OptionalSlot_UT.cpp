@@ -0,0 +1,164 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <OptionalSlot.hpp>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Stats
+{
+  uint64_t count;
+  uint64_t sum;
+};
+
+// util::DtorCalled holds a reference, so it can not be assigned into a slot
+struct Counted
+{
+  unsigned *dtorCalled;
+
+  ~Counted()
+  {
+    ++*dtorCalled;
+  }
+};
+
+} // namespace
+
+TEST(OptionalSlot, layout)
+{
+  static_assert(alignof(OptionalSlot<Stats>) == 64, "");
+  static_assert(sizeof(OptionalSlot<Stats>) == 64, "");
+  static_assert(sizeof(OptionalSlot<char>) == 64, "");
+  static_assert(alignof(OptionalSlot<int, 128>) == 128, "");
+  static_assert(sizeof(OptionalSlot<int, 128>) == 128, "");
+
+  struct Big { char data[100]; };
+  static_assert(sizeof(OptionalSlot<Big>) == 128, "");
+}
+
+TEST(OptionalSlot, valueAccess)
+{
+  OptionalSlot<std::string> slot;
+  EXPECT_FALSE(slot);
+
+  slot = std::string("abc");
+  ASSERT_TRUE(slot.has_value());
+  EXPECT_EQ("abc", *slot);
+  EXPECT_EQ(3u, slot->size());
+  EXPECT_EQ("abc", *slot.get());
+
+  slot.reset();
+  EXPECT_FALSE(slot.get().has_value());
+
+  const OptionalSlot<std::string> fromOpt(Optional<std::string>(std::string("x")));
+  EXPECT_EQ("x", *fromOpt);
+}
+
+TEST(OptionalSlotArray, separateCacheLines)
+{
+  OptionalSlotArray<Stats> slots(5);
+  ASSERT_EQ(5u, slots.size());
+
+  for(size_t i = 0; i < slots.size(); ++i)
+  {
+    const auto addr = reinterpret_cast<uintptr_t>(&slots[i]);
+    EXPECT_EQ(0u, addr % 64);
+    EXPECT_FALSE(slots[i]);
+    if(i > 0)
+    {
+      EXPECT_EQ(64u, addr - reinterpret_cast<uintptr_t>(&slots[i - 1]));
+    }
+  }
+
+  OptionalSlotArray<int, 256> wide(3);
+  for(size_t i = 0; i < wide.size(); ++i)
+  {
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(&wide[i]) % 256);
+  }
+}
+
+TEST(OptionalSlotArray, perWorkerWrites)
+{
+  const size_t workers = 4;
+  OptionalSlotArray<Stats> slots(workers);
+
+  std::vector<std::thread> threads;
+  for(size_t w = 0; w < workers; ++w)
+  {
+    // worker 2 never reports
+    if(w == 2)
+      continue;
+
+    threads.emplace_back([&slots, w] {
+      slots[w] = Stats{0, 0};
+      for(uint64_t i = 0; i < 1000; ++i)
+      {
+        slots[w]->count++;
+        slots[w]->sum += i;
+      }
+    });
+  }
+
+  for(auto &t : threads)
+    t.join();
+
+  size_t reported = 0;
+  uint64_t count = 0;
+  slots.for_each_engaged([&](size_t w, Stats &s) {
+    EXPECT_NE(2u, w);
+    ++reported;
+    count += s.count;
+    EXPECT_EQ(999u * 1000u / 2u, s.sum);
+  });
+
+  EXPECT_EQ(3u, reported);
+  EXPECT_EQ(3000u, count);
+
+  slots.reset_all();
+  slots.for_each_engaged([](size_t, Stats&) { FAIL(); });
+}
+
+TEST(OptionalSlotArray, destroysEngaged)
+{
+  unsigned dtorCalled = 0;
+  {
+    OptionalSlotArray<Counted> slots(3);
+    slots[0] = Counted{&dtorCalled};
+    slots[2] = Counted{&dtorCalled};
+    dtorCalled = 0;
+
+    OptionalSlotArray<Counted> moved(std::move(slots));
+    EXPECT_EQ(0u, slots.size());
+    EXPECT_EQ(3u, moved.size());
+    EXPECT_EQ(0u, dtorCalled);
+  }
+  EXPECT_EQ(2u, dtorCalled);
+}
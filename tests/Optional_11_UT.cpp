@@ -31,6 +31,7 @@
 #include <type_traits>
 #include <cstddef>
 #include <cstdint>
+#include <utility>
 
 
 namespace {
@@ -162,3 +163,31 @@ TEST(Optional_11_UT, dtorCalledOnReset)
   EXPECT_EQ(2, dtorCalled);
 
 }
+
+TEST(Optional_11_UT, copyAssign)
+{
+  Optional<util::Observe> engaged{util::Observe{}};
+  Optional<util::Observe> empty;
+  const Optional<util::Observe> rhs{util::Observe{}};
+
+  engaged = rhs;
+  empty = rhs;
+
+  EXPECT_EQ(util::Event::CopyAssign, engaged->event);
+  EXPECT_EQ(util::Event::CopyCtor, empty->event);
+}
+
+TEST(Optional_11_UT, moveAssign)
+{
+  Optional<util::Observe> engaged{util::Observe{}};
+  Optional<util::Observe> empty;
+
+  engaged = Optional<util::Observe>{util::Observe{}};
+  empty = Optional<util::Observe>{util::Observe{}};
+
+  EXPECT_EQ(util::Event::MoveAssign, engaged->event);
+  EXPECT_EQ(util::Event::MoveCtor, empty->event);
+
+  engaged = Optional<util::Observe>{};
+  EXPECT_FALSE(engaged);
+}
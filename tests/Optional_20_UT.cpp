@@ -31,6 +31,35 @@
 #include <type_traits>
 #include <cstddef>
 #include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct FlagFirstRecord
+{
+  int64_t id;
+  char payload[120];
+};
+
+struct FlagFirstString
+{
+  std::string name;
+  char payload[100];
+};
+
+} // namespace
+
+namespace detail {
+
+template<>
+struct optional_flag_first<FlagFirstRecord> : std::true_type {};
+
+template<>
+struct optional_flag_first<FlagFirstString> : std::true_type {};
+
+} // namespace detail
 
 template<typename T>
 class Optional_20_ArithTests : public testing::Test
@@ -223,3 +252,202 @@ TEST(Optional_20_UT, dtorCalledOnReset)
   EXPECT_EQ(2, dtorCalled);
 
 }
+
+TEST(Optional_20_UT, observeMoveCtorFromOptional)
+{
+  Optional<util::Observe> val{util::Observe{}};
+  const Optional<util::Observe> moved{std::move(val)};
+
+  EXPECT_TRUE(moved);
+  EXPECT_EQ(util::Event::MoveCtor, moved->event);
+}
+
+TEST(Optional_20_UT, copyAssignBothEngaged)
+{
+  Optional<util::Observe> lhs{util::Observe{}};
+  const Optional<util::Observe> rhs{util::Observe{}};
+
+  lhs = rhs;
+
+  EXPECT_TRUE(lhs);
+  EXPECT_TRUE(rhs);
+  EXPECT_EQ(util::Event::CopyAssign, lhs->event);
+}
+
+TEST(Optional_20_UT, moveAssignBothEngaged)
+{
+  Optional<util::Observe> lhs{util::Observe{}};
+  Optional<util::Observe> rhs{util::Observe{}};
+
+  lhs = std::move(rhs);
+
+  EXPECT_TRUE(lhs);
+  EXPECT_EQ(util::Event::MoveAssign, lhs->event);
+}
+
+TEST(Optional_20_UT, copyAssignToEmpty)
+{
+  Optional<util::Observe> lhs;
+  Optional<util::Observe> rhs{util::Observe{}};
+
+  lhs = rhs; // non-const lvalue must not pick value assignment
+
+  EXPECT_TRUE(lhs);
+  EXPECT_TRUE(rhs);
+  EXPECT_EQ(util::Event::CopyCtor, lhs->event);
+}
+
+TEST(Optional_20_UT, moveAssignToEmpty)
+{
+  Optional<util::Observe> lhs;
+  Optional<util::Observe> rhs{util::Observe{}};
+
+  lhs = std::move(rhs);
+
+  EXPECT_TRUE(lhs);
+  EXPECT_EQ(util::Event::MoveCtor, lhs->event);
+}
+
+TEST(Optional_20_UT, assignEmptyResets)
+{
+  Optional<std::string> copied{std::string(64, 'x')};
+  Optional<std::string> moved{std::string(64, 'x')};
+  const Optional<std::string> empty;
+
+  copied = empty;
+  moved = Optional<std::string>{};
+
+  EXPECT_FALSE(copied);
+  EXPECT_FALSE(moved);
+  EXPECT_FALSE(empty);
+}
+
+TEST(Optional_20_UT, copyAssignReusesCapacity)
+{
+  Optional<std::vector<int>> lhs{std::vector<int>(1024, 1)};
+  const Optional<std::vector<int>> rhs{std::vector<int>(512, 2)};
+
+  const int *buffer = lhs->data();
+  lhs = rhs;
+
+  ASSERT_TRUE(lhs);
+  EXPECT_EQ(buffer, lhs->data());
+  EXPECT_EQ(512u, lhs->size());
+  EXPECT_EQ(2, lhs->back());
+}
+
+TEST(Optional_20_UT, noexceptAssign)
+{
+  EXPECT_TRUE(std::is_nothrow_copy_assignable_v<Optional<int>>);
+  EXPECT_TRUE(std::is_nothrow_move_assignable_v<Optional<int>>);
+  EXPECT_TRUE(std::is_nothrow_move_assignable_v<Optional<std::vector<int>>>);
+  EXPECT_FALSE(std::is_nothrow_copy_assignable_v<Optional<std::vector<int>>>);
+  EXPECT_FALSE(std::is_nothrow_move_assignable_v<Optional<util::Observe>>);
+}
+
+TEST(Optional_20_UT, rvalueValueOrByValue)
+{
+  static_assert(std::is_same_v<std::string, decltype(Optional<std::string>{}.value_or("fallback"))>);
+  static_assert(std::is_same_v<int, decltype(Optional<int>{}.value_or(1L))>);
+
+  // the fallback is a temporary, a reference to it would dangle by the next statement
+  const std::string fallback = Optional<std::string>{}.value_or(std::string(40, 'f'));
+  EXPECT_EQ(std::string(40, 'f'), fallback);
+
+  const int converted = Optional<int>{}.value_or(7L);
+  EXPECT_EQ(7, converted);
+
+  Optional<std::string> engaged{std::string(40, 'e')};
+  const std::string moved = std::move(engaged).value_or("fallback");
+  EXPECT_EQ(std::string(40, 'e'), moved);
+  ASSERT_TRUE(engaged.has_value());
+  EXPECT_TRUE(engaged->empty());
+}
+
+TEST(Optional_20_UT, reference)
+{
+  int val = 5;
+  int other = 7;
+
+  Optional<int&> ref{val};
+  const Optional<int&> empty;
+
+  ASSERT_TRUE(ref);
+  EXPECT_FALSE(empty);
+  EXPECT_EQ(&val, &*ref);
+  EXPECT_EQ(5, ref.value_or(1));
+  EXPECT_EQ(1, empty.value_or(1));
+  EXPECT_EQ(sizeof(int*), sizeof(ref));
+  EXPECT_TRUE(std::is_trivially_copyable_v<Optional<int&>>);
+  EXPECT_FALSE((std::is_constructible_v<Optional<const int&>, int&&>));
+
+  *ref = 6;
+  EXPECT_EQ(6, val);
+
+  ref = Optional<int&>{other}; // rebinds
+  EXPECT_EQ(&other, &*ref);
+  EXPECT_EQ(6, val);
+
+  Optional<int&> swapped{val};
+  swap(ref, swapped);
+  EXPECT_EQ(&val, &*ref);
+  EXPECT_EQ(&other, &*swapped);
+
+  ref.reset();
+  EXPECT_FALSE(ref);
+}
+
+TEST(Optional_20_UT, constReferenceArrow)
+{
+  const std::string str{"abc"};
+  const Optional<const std::string&> ref{str};
+
+  EXPECT_EQ(3u, ref->size());
+  EXPECT_EQ(std::string("x"), Optional<const std::string&>{}.value_or("x"));
+}
+
+TEST(Optional_20_UT, flagFirstLayout)
+{
+  using Storage = detail::optional_storage<FlagFirstRecord>;
+  using DefaultStorage = detail::optional_storage<int64_t>;
+
+  static_assert(offsetof(Storage, engaged) == 0);
+  static_assert(offsetof(DefaultStorage, engaged) == sizeof(int64_t));
+  static_assert(offsetof(detail::optional_storage<FlagFirstString>, engaged) == 0);
+
+  static_assert(sizeof(Optional<FlagFirstRecord>) == sizeof(FlagFirstRecord) + alignof(FlagFirstRecord));
+  static_assert(std::is_trivially_destructible_v<Optional<FlagFirstRecord>>);
+  static_assert(!std::is_trivially_destructible_v<Optional<FlagFirstString>>);
+  static_assert(std::is_same_v<detail::optional_storage<const FlagFirstRecord>, Storage>);
+
+  Optional<FlagFirstRecord> rec(FlagFirstRecord{7, {'a'}});
+  ASSERT_TRUE(rec);
+  EXPECT_EQ(7, rec->id);
+  EXPECT_EQ('a', rec->payload[0]);
+
+  const auto copy = rec;
+  rec.reset();
+  EXPECT_FALSE(rec);
+  EXPECT_EQ(7, copy->id);
+}
+
+TEST(Optional_20_UT, flagFirstNonTrivial)
+{
+  Optional<FlagFirstString> str(FlagFirstString{std::string(64, 'x'), {}});
+  Optional<FlagFirstString> other;
+
+  other = str;
+  ASSERT_TRUE(other);
+  EXPECT_EQ(64u, other->name.size());
+
+  Optional<FlagFirstString> moved(std::move(other));
+  EXPECT_EQ(std::string(64, 'x'), moved->name);
+
+  other.reset();
+  swap(moved, other);
+  EXPECT_FALSE(moved);
+  EXPECT_EQ(std::string(64, 'x'), other->name);
+
+  other.reset();
+  EXPECT_FALSE(other);
+}
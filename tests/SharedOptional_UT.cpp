@@ -0,0 +1,274 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <SharedOptional.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Counted
+{
+  static std::atomic<int> alive;
+
+  int value;
+
+  explicit Counted(int val)
+    : value{val}
+  {
+    ++alive;
+  }
+
+  Counted(const Counted &other)
+    : value{other.value}
+  {
+    ++alive;
+  }
+
+  ~Counted()
+  {
+    --alive;
+  }
+};
+
+std::atomic<int> Counted::alive{0};
+
+// every field derived from seq, a reader sees a torn or freed payload as a mismatch
+struct Snapshot
+{
+  uint64_t seq;
+  uint64_t check;
+  std::string text;
+
+  explicit Snapshot(uint64_t s)
+    : seq{s}, check{~s}, text(std::to_string(s) + std::string(32, 'x'))
+  {}
+
+  ~Snapshot()
+  {
+    seq = 0;
+    check = 0;
+  }
+
+  bool consistent() const
+  {
+    return check == ~seq && text == std::to_string(seq) + std::string(32, 'x');
+  }
+};
+
+template<size_t ReaderSlots>
+void stress(unsigned readerCount, unsigned writerCount, uint64_t writes)
+{
+  SharedOptional<Snapshot, ReaderSlots> shared{Snapshot{1}};
+  std::atomic<unsigned> writersLeft{writerCount};
+  std::atomic<uint64_t> torn{0};
+  std::atomic<uint64_t> reads{0};
+
+  std::vector<std::thread> threads;
+  for(unsigned r = 0; r < readerCount; ++r)
+  {
+    threads.emplace_back([&] {
+      uint64_t local = 0;
+      while(writersLeft.load(std::memory_order_acquire) != 0 || local < 1000)
+      {
+        const auto guard = shared.read();
+        if(guard && !guard->consistent())
+          ++torn;
+
+        const Optional<const Snapshot&> snap = guard.get();
+        if(snap.has_value() != guard.has_value())
+          ++torn;
+
+        ++local;
+      }
+      reads += local;
+    });
+  }
+
+  for(unsigned w = 0; w < writerCount; ++w)
+  {
+    threads.emplace_back([&, w] {
+      for(uint64_t i = 1; i <= writes; ++i)
+      {
+        if(i % 7 == 0)
+          shared.reset();
+        else
+          shared.emplace(i * writerCount + w);
+      }
+      --writersLeft;
+    });
+  }
+
+  for(auto &t : threads)
+    t.join();
+
+  EXPECT_EQ(0u, torn.load());
+  EXPECT_GE(reads.load(), readerCount * 1000u);
+}
+
+} // namespace
+
+TEST(SharedOptional, emptyByDefault)
+{
+  SharedOptional<int> shared;
+  EXPECT_FALSE(shared.has_value());
+
+  const auto guard = shared.read();
+  EXPECT_FALSE(guard);
+  EXPECT_FALSE(guard.get().has_value());
+  EXPECT_FALSE(shared.load().has_value());
+}
+
+TEST(SharedOptional, constructEngaged)
+{
+  SharedOptional<std::string> shared{std::string("config")};
+  ASSERT_TRUE(shared.has_value());
+
+  {
+    const auto guard = shared.read();
+    ASSERT_TRUE(guard);
+    EXPECT_EQ("config", *guard);
+    EXPECT_EQ(6u, guard->size());
+
+    const Optional<const std::string&> ref = guard.get();
+    ASSERT_TRUE(ref.has_value());
+    EXPECT_EQ(&*guard, &*ref);
+  }
+
+  const Optional<std::string> copy = shared.load();
+  ASSERT_TRUE(copy.has_value());
+  EXPECT_EQ("config", *copy);
+}
+
+TEST(SharedOptional, storeEmplaceReset)
+{
+  SharedOptional<std::string> shared;
+
+  shared.store(std::string("a"));
+  EXPECT_EQ("a", *shared.load());
+
+  const std::string b = "b";
+  shared.store(b);
+  EXPECT_EQ("b", *shared.load());
+
+  shared.emplace(3u, 'c');
+  EXPECT_EQ("ccc", *shared.load());
+
+  shared.reset();
+  EXPECT_FALSE(shared.has_value());
+  EXPECT_FALSE(shared.read());
+
+  shared.reset();
+  EXPECT_FALSE(shared.has_value());
+}
+
+TEST(SharedOptional, nestedGuards)
+{
+  SharedOptional<int> shared{5};
+
+  const auto outer = shared.read();
+  const auto inner = shared.read();
+  EXPECT_EQ(&*outer, &*inner);
+}
+
+TEST(SharedOptional, movedGuard)
+{
+  SharedOptional<int> shared{5};
+
+  auto first = shared.read();
+  const auto second = std::move(first);
+  ASSERT_TRUE(second);
+  EXPECT_EQ(5, *second);
+}
+
+TEST(SharedOptional, replacedPayloadsDestroyed)
+{
+  ASSERT_EQ(0, Counted::alive.load());
+  {
+    SharedOptional<Counted> shared{Counted{1}};
+    EXPECT_EQ(1, Counted::alive.load());
+
+    for(int i = 0; i < 10; ++i)
+      shared.emplace(i);
+    EXPECT_EQ(1, Counted::alive.load());
+    EXPECT_EQ(9, shared.read()->value);
+
+    shared.reset();
+    EXPECT_EQ(0, Counted::alive.load());
+
+    shared.emplace(11);
+    EXPECT_EQ(1, Counted::alive.load());
+  }
+  EXPECT_EQ(0, Counted::alive.load());
+}
+
+TEST(SharedOptional, guardKeepsSnapshotAlive)
+{
+  SharedOptional<Counted> shared{Counted{1}};
+  std::atomic<bool> stored{false};
+
+  std::thread writer;
+  {
+    const auto guard = shared.read();
+    ASSERT_TRUE(guard);
+
+    writer = std::thread([&] {
+      shared.emplace(2);
+      stored = true;
+    });
+
+    // the writer has to wait for this guard before it can free the old payload
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(stored.load());
+    EXPECT_EQ(1, guard->value);
+    EXPECT_EQ(2, Counted::alive.load());
+  }
+
+  writer.join();
+  EXPECT_TRUE(stored.load());
+  EXPECT_EQ(1, Counted::alive.load());
+  EXPECT_EQ(2, shared.read()->value);
+}
+
+TEST(SharedOptional, stressReadersWriters)
+{
+  stress<detail::SHARED_READER_SLOTS>(4, 2, 200);
+}
+
+TEST(SharedOptional, stressSharedReaderSlot)
+{
+  stress<1>(4, 2, 200);
+}
+
+TEST(SharedOptional, stressMoreReadersThanSlots)
+{
+  stress<2>(3, 1, 200);
+}
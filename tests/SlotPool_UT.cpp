@@ -0,0 +1,201 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <SlotPool.hpp>
+
+#include "Common.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct ThrowOnZero
+{
+  int val;
+
+  explicit ThrowOnZero(int v)
+    : val{v}
+  {
+    if(v == 0)
+      throw std::runtime_error("zero");
+  }
+};
+
+} // namespace
+
+TEST(SlotPool, insertGetErase)
+{
+  SlotPool<std::string> pool;
+  EXPECT_TRUE(pool.empty());
+
+  const auto a = pool.insert("a");
+  const auto b = pool.insert(3u, 'b');
+  ASSERT_EQ(2u, pool.size());
+
+  ASSERT_TRUE(pool.get(a));
+  EXPECT_EQ("a", *pool.get(a));
+  EXPECT_EQ("bbb", *pool.get(b));
+
+  pool.get(a)->append("!");
+  EXPECT_EQ("a!", *pool.get(a));
+
+  EXPECT_TRUE(pool.erase(a));
+  EXPECT_FALSE(pool.get(a));
+  EXPECT_FALSE(pool.contains(a));
+  EXPECT_FALSE(pool.erase(a));
+  EXPECT_EQ(1u, pool.size());
+
+  const SlotPool<std::string> &constPool = pool;
+  EXPECT_EQ("bbb", *constPool.get(b));
+}
+
+TEST(SlotPool, staleHandleAfterReuse)
+{
+  SlotPool<int> pool;
+  const auto first = pool.insert(1);
+  pool.erase(first);
+
+  const auto second = pool.insert(2);
+  EXPECT_EQ(first.index, second.index);
+  EXPECT_NE(first, second);
+
+  EXPECT_FALSE(pool.get(first));
+  EXPECT_EQ(2, *pool.get(second));
+  EXPECT_FALSE(pool.erase(first));
+  EXPECT_EQ(2, *pool.get(second));
+}
+
+TEST(SlotPool, invalidHandles)
+{
+  SlotPool<int> pool;
+  EXPECT_FALSE(pool.get(SlotHandle{}));
+
+  const auto h = pool.insert(1);
+  EXPECT_FALSE(pool.get(SlotHandle{}));
+  EXPECT_FALSE(pool.get(SlotHandle{h.index + 1, h.generation}));
+  EXPECT_FALSE(pool.get(SlotHandle{h.index, h.generation + 1}));
+  EXPECT_FALSE(pool.get(SlotHandle{1000000, 1}));
+}
+
+TEST(SlotPool, chunksDoNotMove)
+{
+  SlotPool<int, 4> pool;
+
+  std::vector<SlotHandle> handles;
+  std::vector<const int*> addresses;
+  for(int i = 0; i < 100; ++i)
+  {
+    handles.push_back(pool.insert(i));
+    addresses.push_back(&*pool.get(handles.back()));
+  }
+
+  EXPECT_EQ(100u, pool.capacity());
+  for(int i = 0; i < 100; ++i)
+  {
+    EXPECT_EQ(addresses[static_cast<size_t>(i)], &*pool.get(handles[static_cast<size_t>(i)]));
+    EXPECT_EQ(i, *pool.get(handles[static_cast<size_t>(i)]));
+  }
+}
+
+TEST(SlotPool, freeListReuse)
+{
+  SlotPool<int, 4> pool;
+
+  std::vector<SlotHandle> handles;
+  for(int i = 0; i < 8; ++i)
+    handles.push_back(pool.insert(i));
+
+  for(size_t i = 0; i < 8; i += 2)
+    pool.erase(handles[i]);
+
+  for(int i = 0; i < 4; ++i)
+    pool.insert(100 + i);
+
+  EXPECT_EQ(8u, pool.size());
+  EXPECT_EQ(8u, pool.capacity());
+
+  int sum = 0;
+  size_t visited = 0;
+  pool.for_each([&](SlotHandle h, int &val) {
+    EXPECT_EQ(val, *pool.get(h));
+    sum += val;
+    ++visited;
+  });
+  EXPECT_EQ(8u, visited);
+  EXPECT_EQ(1 + 3 + 5 + 7 + 100 + 101 + 102 + 103, sum);
+}
+
+TEST(SlotPool, clearAndDtors)
+{
+  unsigned dtorCalled = 0;
+  SlotHandle kept;
+  {
+    SlotPool<util::DtorCalled> pool;
+    kept = pool.insert(dtorCalled);
+    const auto erased = pool.insert(dtorCalled);
+    pool.insert(dtorCalled);
+
+    pool.erase(erased);
+    EXPECT_EQ(1u, dtorCalled);
+
+    pool.clear();
+    EXPECT_EQ(3u, dtorCalled);
+    EXPECT_TRUE(pool.empty());
+    EXPECT_FALSE(pool.get(kept));
+
+    pool.insert(dtorCalled);
+  }
+  EXPECT_EQ(4u, dtorCalled);
+}
+
+TEST(SlotPool, throwingConstructor)
+{
+  SlotPool<ThrowOnZero> pool;
+  const auto one = pool.insert(1);
+
+  EXPECT_THROW(pool.insert(0), std::runtime_error);
+  EXPECT_EQ(1u, pool.size());
+
+  const auto two = pool.insert(2);
+  EXPECT_EQ(1u, two.index);
+  EXPECT_EQ(1, pool.get(one)->val);
+  EXPECT_EQ(2, pool.get(two)->val);
+}
+
+TEST(SlotPool, move)
+{
+  SlotPool<std::string> pool;
+  const auto h = pool.insert("x");
+
+  SlotPool<std::string> moved(std::move(pool));
+  EXPECT_EQ("x", *moved.get(h));
+  EXPECT_TRUE(pool.empty());
+
+  pool = std::move(moved);
+  EXPECT_EQ("x", *pool.get(h));
+}
@@ -0,0 +1,356 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Pawel Drzycimski
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <SmallOptionalVector.hpp>
+
+#include "Common.hpp"
+
+#include <memory>
+#include <string>
+
+namespace {
+
+// counts move constructions, relocation by memcpy skips them
+struct Tracked
+{
+  static unsigned moves;
+  int val;
+
+  explicit Tracked(int v)
+    : val{v}
+  {}
+
+  Tracked(const Tracked&) = default;
+
+  Tracked(Tracked &&other) noexcept
+    : val{other.val}
+  {
+    ++moves;
+  }
+
+  ~Tracked() {}
+};
+
+unsigned Tracked::moves = 0;
+
+struct RelocateFailure {};
+
+// the move may throw, so relocation copies; the copy throws once 'copiesLeft' runs out
+struct ThrowingCopy
+{
+  static int copiesLeft;
+  std::string str;
+
+  explicit ThrowingCopy(const char *s)
+    : str(s)
+  {}
+
+  ThrowingCopy(const ThrowingCopy &other)
+    : str(other.str)
+  {
+    if(copiesLeft-- == 0)
+      throw RelocateFailure{};
+  }
+
+  ThrowingCopy(ThrowingCopy &&other) noexcept(false)
+    : str(std::move(other.str))
+  {}
+};
+
+int ThrowingCopy::copiesLeft = -1;
+
+// move only with a move that may throw, relocation has to move and throws on 'movesLeft'
+struct ThrowingMove
+{
+  static int movesLeft;
+  std::unique_ptr<std::string> str;
+
+  explicit ThrowingMove(const char *s)
+    : str(new std::string(s))
+  {}
+
+  ThrowingMove(ThrowingMove &&other) noexcept(false)
+    : str(nullptr)
+  {
+    if(movesLeft-- == 0)
+      throw RelocateFailure{};
+
+    str = std::move(other.str);
+  }
+};
+
+int ThrowingMove::movesLeft = -1;
+
+struct RelocatableTracked : Tracked
+{
+  using Tracked::Tracked;
+};
+
+} // namespace
+
+namespace detail {
+
+template<>
+struct is_trivially_relocatable<RelocatableTracked> : std::true_type {};
+
+} // namespace detail
+
+TEST(SmallOptionalVector, staysInline)
+{
+  SmallOptionalVector<int, 4> vec;
+  EXPECT_TRUE(vec.empty());
+  EXPECT_TRUE(vec.is_inline());
+
+  vec.push_back(1);
+  vec.push_back(Optional<int>());
+  vec.emplace_back(3);
+  vec.push_back(Optional<int>(4));
+
+  ASSERT_EQ(4u, vec.size());
+  EXPECT_TRUE(vec.is_inline());
+  EXPECT_EQ(4u, vec.capacity());
+
+  EXPECT_EQ(1, *vec[0]);
+  EXPECT_FALSE(vec[1]);
+  EXPECT_EQ(3, *vec[2]);
+  EXPECT_EQ(4, *vec.back());
+}
+
+TEST(SmallOptionalVector, spillsToHeap)
+{
+  SmallOptionalVector<std::string, 2> vec;
+  for(int i = 0; i < 10; ++i)
+  {
+    if(i % 3 == 0)
+      vec.push_back(Optional<std::string>());
+    else
+      vec.push_back(std::to_string(i));
+  }
+
+  ASSERT_EQ(10u, vec.size());
+  EXPECT_FALSE(vec.is_inline());
+  EXPECT_GE(vec.capacity(), 10u);
+
+  int i = 0;
+  for(const auto &opt : vec)
+  {
+    ASSERT_EQ(i % 3 != 0, opt.has_value()) << i;
+    if(opt)
+    {
+      EXPECT_EQ(std::to_string(i), *opt);
+    }
+    ++i;
+  }
+}
+
+TEST(SmallOptionalVector, pushBackOwnElement)
+{
+  SmallOptionalVector<std::string, 1> vec;
+  vec.push_back(std::string("self"));
+  vec.push_back(vec[0]);
+  vec.push_back(vec[1]);
+
+  ASSERT_EQ(3u, vec.size());
+  EXPECT_EQ("self", *vec[2]);
+}
+
+TEST(SmallOptionalVector, emplaceBackOwnElement)
+{
+  // long enough to live on the heap, a read from the moved out element would come back empty
+  const std::string str(40, 'x');
+
+  SmallOptionalVector<std::string, 1> vec;
+  vec.emplace_back(str);
+  vec.emplace_back(*vec[0]);
+  vec.emplace_back(*vec[1], 0u, 20u);
+
+  ASSERT_EQ(3u, vec.size());
+  EXPECT_EQ(str, *vec[0]);
+  EXPECT_EQ(str, *vec[1]);
+  EXPECT_EQ(str.substr(0, 20), *vec[2]);
+}
+
+TEST(SmallOptionalVector, clearDestroysOnlyEngaged)
+{
+  unsigned dtorCalled = 0;
+  {
+    SmallOptionalVector<util::DtorCalled, 2> vec;
+    vec.push_back(Optional<util::DtorCalled>(util::DtorCalled{dtorCalled}));
+    vec.push_back(Optional<util::DtorCalled>());
+    vec.push_back(Optional<util::DtorCalled>(util::DtorCalled{dtorCalled}));
+    vec.push_back(Optional<util::DtorCalled>());
+    dtorCalled = 0;
+
+    vec.clear();
+    EXPECT_EQ(2u, dtorCalled);
+    EXPECT_TRUE(vec.empty());
+
+    vec.push_back(Optional<util::DtorCalled>(util::DtorCalled{dtorCalled}));
+    dtorCalled = 0;
+    vec.reset_all();
+    EXPECT_EQ(1u, dtorCalled);
+    ASSERT_EQ(1u, vec.size());
+    EXPECT_FALSE(vec[0]);
+  }
+  EXPECT_EQ(1u, dtorCalled);
+}
+
+TEST(SmallOptionalVector, resizeAndPop)
+{
+  SmallOptionalVector<std::string, 2> vec{std::string("a"), Optional<std::string>(), std::string("c")};
+  ASSERT_EQ(3u, vec.size());
+
+  vec.resize(5);
+  ASSERT_EQ(5u, vec.size());
+  EXPECT_FALSE(vec[3]);
+  EXPECT_FALSE(vec[4]);
+
+  vec.resize(1);
+  ASSERT_EQ(1u, vec.size());
+  EXPECT_EQ("a", *vec[0]);
+
+  vec.pop_back();
+  EXPECT_TRUE(vec.empty());
+}
+
+TEST(SmallOptionalVector, relocation)
+{
+  Tracked::moves = 0;
+  SmallOptionalVector<Tracked, 2> moved;
+  moved.emplace_back(1);
+  moved.emplace_back(2);
+  const unsigned afterFill = Tracked::moves;
+  moved.emplace_back(3);
+  EXPECT_EQ(afterFill + 2u + 1u, Tracked::moves);
+
+  Tracked::moves = 0;
+  SmallOptionalVector<RelocatableTracked, 2> copied;
+  copied.emplace_back(1);
+  copied.emplace_back(2);
+  const unsigned afterFillRelocatable = Tracked::moves;
+  copied.emplace_back(3);
+  EXPECT_EQ(afterFillRelocatable + 1u, Tracked::moves);
+
+  ASSERT_EQ(3u, copied.size());
+  EXPECT_EQ(1, copied[0]->val);
+  EXPECT_EQ(2, copied[1]->val);
+  EXPECT_EQ(3, copied[2]->val);
+}
+
+TEST(SmallOptionalVector, copyAndMove)
+{
+  SmallOptionalVector<std::string, 2> small{std::string("x")};
+  SmallOptionalVector<std::string, 2> big{std::string("a"), std::string("b"), Optional<std::string>()};
+
+  auto smallCopy = small;
+  auto bigCopy = big;
+  EXPECT_EQ("x", *smallCopy[0]);
+  ASSERT_EQ(3u, bigCopy.size());
+  EXPECT_EQ("b", *bigCopy[1]);
+
+  auto smallMoved = std::move(smallCopy);
+  EXPECT_TRUE(smallMoved.is_inline());
+  EXPECT_EQ("x", *smallMoved[0]);
+  EXPECT_TRUE(smallCopy.empty());
+
+  const std::string *heapElem = bigCopy[0].operator->();
+  auto bigMoved = std::move(bigCopy);
+  EXPECT_FALSE(bigMoved.is_inline());
+  EXPECT_EQ(heapElem, bigMoved[0].operator->());
+  EXPECT_TRUE(bigCopy.is_inline());
+
+  bigMoved = small;
+  ASSERT_EQ(1u, bigMoved.size());
+  EXPECT_EQ("x", *bigMoved[0]);
+
+  smallMoved = std::move(big);
+  ASSERT_EQ(3u, smallMoved.size());
+  EXPECT_FALSE(smallMoved[2]);
+}
+
+TEST(SmallOptionalVector, moveOnly)
+{
+  SmallOptionalVector<std::unique_ptr<int>, 1> vec;
+  vec.emplace_back(new int(1));
+  vec.emplace_back(new int(2));
+
+  auto moved = std::move(vec);
+  ASSERT_EQ(2u, moved.size());
+  EXPECT_EQ(2, **moved[1]);
+}
+
+TEST(SmallOptionalVector, emplaceBackInPlace)
+{
+  SmallOptionalVector<util::Observe, 2> vec;
+  vec.emplace_back();
+
+  ASSERT_TRUE(vec[0]);
+  EXPECT_EQ(util::Event::DefaultCtor, vec[0]->event);
+}
+
+TEST(SmallOptionalVector, growCopiesWhenMoveCanThrow)
+{
+  SmallOptionalVector<ThrowingCopy, 2> vec;
+  vec.emplace_back("first, long enough to live on the heap");
+  vec.emplace_back("second, long enough to live on the heap");
+  vec.push_back(Optional<ThrowingCopy>());
+
+  ThrowingCopy::copiesLeft = 1;
+  EXPECT_THROW(vec.reserve(16), RelocateFailure);
+  ThrowingCopy::copiesLeft = -1;
+
+  EXPECT_TRUE(vec.is_inline() || vec.capacity() == 4);
+  ASSERT_EQ(3u, vec.size());
+  EXPECT_EQ("first, long enough to live on the heap", vec[0]->str);
+  EXPECT_EQ("second, long enough to live on the heap", vec[1]->str);
+  EXPECT_FALSE(vec[2]);
+
+  vec.reserve(16);
+  EXPECT_EQ(16u, vec.capacity());
+  EXPECT_EQ("second, long enough to live on the heap", vec[1]->str);
+}
+
+TEST(SmallOptionalVector, throwingMoveKeepsOldBuffer)
+{
+  SmallOptionalVector<ThrowingMove, 2> vec;
+  vec.emplace_back("first");
+  vec.emplace_back("second");
+
+  ThrowingMove::movesLeft = 1;
+  EXPECT_THROW(vec.reserve(8), RelocateFailure);
+  ThrowingMove::movesLeft = -1;
+
+  // no copy to fall back on: the element moved before the throw is gone, like in std::vector,
+  // but the vector keeps its old buffer and every element in it is alive
+  EXPECT_TRUE(vec.is_inline());
+  ASSERT_EQ(2u, vec.size());
+  EXPECT_FALSE(vec[0]->str);
+  ASSERT_TRUE(vec[1]->str);
+  EXPECT_EQ("second", *vec[1]->str);
+
+  vec.emplace_back("third");
+  EXPECT_EQ("third", *vec[2]->str);
+}
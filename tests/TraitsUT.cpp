@@ -139,6 +139,40 @@ TEST(TraitsUT, noexceptCopyCtor)
   EXPECT_FALSE(detail::is_noxcept_move_constructible<TypeExplicitThrowCopy>::value);
 }
 
+TEST(TraitsUT, noexceptAssign)
+{
+  struct TypeDefaultAssign
+  {
+    int placeholder {0};
+  };
+
+  struct TypeThrowAssign
+  {
+    int placeholder {0};
+
+    TypeThrowAssign& operator=(const TypeThrowAssign&) { return *this; }
+    TypeThrowAssign& operator=(TypeThrowAssign&&) { return *this; }
+  };
+
+  struct TypeNoexceptMoveAssign
+  {
+    int placeholder {0};
+
+    TypeNoexceptMoveAssign& operator=(const TypeNoexceptMoveAssign&) { return *this; }
+    TypeNoexceptMoveAssign& operator=(TypeNoexceptMoveAssign&&) noexcept { return *this; }
+  };
+
+  EXPECT_TRUE(detail::is_noexcept_copy_assignable<int>::value);
+  EXPECT_TRUE(detail::is_noexcept_copy_assignable<TypeDefaultAssign>::value);
+  EXPECT_FALSE(detail::is_noexcept_copy_assignable<TypeThrowAssign>::value);
+  EXPECT_FALSE(detail::is_noexcept_copy_assignable<TypeNoexceptMoveAssign>::value);
+
+  EXPECT_TRUE(detail::is_noexcept_move_assignable<int>::value);
+  EXPECT_TRUE(detail::is_noexcept_move_assignable<TypeDefaultAssign>::value);
+  EXPECT_FALSE(detail::is_noexcept_move_assignable<TypeThrowAssign>::value);
+  EXPECT_TRUE(detail::is_noexcept_move_assignable<TypeNoexceptMoveAssign>::value);
+}
+
 namespace {
   struct HasNoexceptSwap
   {